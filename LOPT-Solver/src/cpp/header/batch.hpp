@@ -0,0 +1,26 @@
+/*
+ * batch.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_BATCH_HPP_
+#define SRC_CPP_HEADER_BATCH_HPP_
+
+#include <string>
+#include <vector>
+#include "solver.hpp"
+
+struct BatchTable {
+	std::string path;
+	unsigned int inputs = 0;
+	unsigned int outputs = 0;
+	// set if the manifest line of the table is invalid, the table is counted as failed without loading it
+	bool invalid = false;
+};
+
+bool collect_batch_tables(const std::string& source, unsigned int inputs, unsigned int outputs, std::vector<BatchTable>& tables);
+bool run_batch(const std::vector<BatchTable>& tables, const SolverOptions& options, const std::string& outputDirectory);
+
+#endif /* SRC_CPP_HEADER_BATCH_HPP_ */
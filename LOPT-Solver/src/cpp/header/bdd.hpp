@@ -0,0 +1,115 @@
+/*
+ * bdd.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_BDD_HPP_
+#define SRC_CPP_HEADER_BDD_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include "truthtable.hpp"
+#include "qmcp.hpp"
+
+// number of minterms added to the chart per round, when an cover does not cover all minterms of the function
+#define BDD_UNCOVERED_MINTERMS_PER_ROUND 16
+
+// nodes are referenced by their index in the node table, the first two nodes are the constants
+typedef unsigned int bdd_node_t;
+#define BDD_FALSE 0
+#define BDD_TRUE 1
+
+struct BDDNode {
+	unsigned int variable;
+	bdd_node_t low;
+	bdd_node_t high;
+
+	bool operator==(const BDDNode& other) const = default;
+};
+
+struct BDDNodeHash {
+	size_t operator()(const BDDNode& node) const;
+};
+
+enum BDDOperation {
+	BDD_AND = 0,
+	BDD_OR = 1,
+	BDD_AND_NOT = 2,
+	// the function for an fixed value of an variable, only used by cofactor()
+	BDD_COFACTOR = 3
+};
+
+struct BDDOperationKey {
+	BDDOperation operation;
+	bdd_node_t a;
+	bdd_node_t b;
+
+	bool operator==(const BDDOperationKey& other) const = default;
+};
+
+struct BDDOperationKeyHash {
+	size_t operator()(const BDDOperationKey& key) const;
+};
+
+/**
+ * An table of reduced ordered binary decision diagram nodes, with input 0 as the top variable.
+ * Equal nodes are only stored once, so two functions are equal if their root nodes are equal.
+ */
+class BDDManager {
+
+private:
+	unsigned int variables;
+	std::vector<BDDNode> nodes;
+	std::unordered_map<BDDNode, bdd_node_t, BDDNodeHash> uniqueTable;
+	std::unordered_map<BDDOperationKey, bdd_node_t, BDDOperationKeyHash> computedTable;
+	std::unordered_map<bdd_node_t, std::vector<QMCCube>> primeTable;
+
+	bool findPath(bdd_node_t function, const QMCCube& cube, uint64_t& state, std::unordered_set<bdd_node_t>& dead) const;
+	const std::vector<QMCCube>& primes(bdd_node_t function);
+
+public:
+	BDDManager(unsigned int variables);
+
+	bdd_node_t makeNode(unsigned int variable, bdd_node_t low, bdd_node_t high);
+	bdd_node_t cube(const QMCCube& cube);
+	bdd_node_t apply(BDDOperation operation, bdd_node_t a, bdd_node_t b);
+	bdd_node_t cofactor(bdd_node_t function, unsigned int variable, bool value);
+	const BDDNode& node(bdd_node_t function) const;
+	bool pickState(bdd_node_t function, const QMCCube& cube, uint64_t& state) const;
+	void primeImplicants(bdd_node_t function, std::vector<QMCCube>& primes);
+	unsigned int nodeCount() const;
+	unsigned int variableCount() const;
+
+};
+
+/**
+ * The ON and DONT_CARE set of an output as binary decision diagrams, built directly from the rows of the truth table.
+ */
+class BDDFunction {
+
+private:
+	BDDManager manager;
+	bdd_node_t onSet = BDD_FALSE;
+	bdd_node_t dcSet = BDD_FALSE;
+	std::vector<QMCCube> primes;
+
+public:
+	BDDFunction(unsigned int variables);
+
+	void initialize(const TruthTable& table, unsigned int output);
+	void primeImplicants(std::vector<QMCImplicant>& primes);
+	void sampleMinterms(const std::vector<QMCImplicant>& primes, std::vector<QMCMinterm>& minterms);
+	bool uncoveredMinterms(const std::vector<QMCImplicant>& cover, std::vector<QMCMinterm>& minterms);
+	void restrictToCore(bdd_node_t onSet, const std::vector<QMCCube>& primes, std::vector<QMCImplicant>& implicants);
+	BDDManager& diagram();
+	bdd_node_t onSetFunction() const;
+	bdd_node_t dcSetFunction() const;
+	unsigned int nodeCount() const;
+
+};
+
+#endif /* SRC_CPP_HEADER_BDD_HPP_ */
@@ -0,0 +1,40 @@
+/*
+ * benchmark.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_BENCHMARK_HPP_
+#define SRC_CPP_HEADER_BENCHMARK_HPP_
+
+#include <string>
+#include <vector>
+#include "qmcp.hpp"
+#include "threadpool.hpp"
+
+// the generated tables contain all states, so the number of inputs has to be kept small
+#define BENCHMARK_MAX_INPUTS 20
+
+struct BenchmarkTable {
+	std::string name;
+	std::string tableText;
+	unsigned int inputs = 0;
+	unsigned int outputs = 0;
+};
+
+enum BenchmarkStage {
+	LOAD = 0,
+	KVMAP = 1,
+	MERGE = 2,
+	CHART = 3,
+	REDUCE = 4,
+	COVER = 5,
+	STAGE_COUNT = 6
+};
+
+bool generate_table(const std::string& spec, BenchmarkTable& table);
+void benchmark_suite(std::vector<std::string>& specs);
+bool run_benchmarks(const std::vector<std::string>& specs, unsigned int runs, QMCCoverMethod coverMethod, ThreadPool* mergePool);
+
+#endif /* SRC_CPP_HEADER_BENCHMARK_HPP_ */
@@ -0,0 +1,45 @@
+/*
+ * bitset.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_BITSET_HPP_
+#define SRC_CPP_HEADER_BITSET_HPP_
+
+#include <vector>
+#include <cstdint>
+
+class BitSet {
+
+private:
+	std::vector<uint64_t> words;
+	unsigned int bits = 0;
+
+public:
+	BitSet();
+	BitSet(unsigned int size);
+
+	void resize(unsigned int size);
+	void clear();
+	void set(unsigned int bit);
+	void reset(unsigned int bit);
+	bool test(unsigned int bit) const;
+	unsigned int next(unsigned int bit) const;
+	unsigned int count() const;
+	unsigned int countWithout(const BitSet& other) const;
+	unsigned int size() const;
+	bool any() const;
+	bool intersects(const BitSet& other) const;
+	bool includes(const BitSet& other) const;
+	void subtract(const BitSet& other);
+
+	BitSet& operator|=(const BitSet& other);
+	BitSet& operator&=(const BitSet& other);
+	bool operator==(const BitSet& other) const;
+	bool operator!=(const BitSet& other) const;
+
+};
+
+#endif /* SRC_CPP_HEADER_BITSET_HPP_ */
@@ -0,0 +1,42 @@
+/*
+ * coversolver.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_COVERSOLVER_HPP_
+#define SRC_CPP_HEADER_COVERSOLVER_HPP_
+
+#include <vector>
+#include <cstdint>
+#include "bitset.hpp"
+
+class CoverSolver {
+
+private:
+	unsigned int columns;
+	std::vector<BitSet> rows;
+	std::vector<unsigned int> costs;
+	std::vector<BitSet> columnRows;
+
+	std::vector<unsigned int> selection;
+	std::vector<unsigned int> best;
+	unsigned int bestCost;
+	bool solved;
+	uint64_t nodes;
+
+	void greedyCover(const BitSet& uncovered);
+	unsigned int lowerBound(const BitSet& uncovered, const BitSet& excluded) const;
+	void excludeDominatedRows(const BitSet& uncovered, BitSet& excluded, std::vector<unsigned int>& dominated) const;
+	void search(const BitSet& uncovered, BitSet& excluded, unsigned int cost);
+
+public:
+	CoverSolver(const std::vector<BitSet>& rows, const std::vector<unsigned int>& costs, unsigned int columns);
+
+	bool solve(std::vector<unsigned int>& selectedRows);
+	uint64_t nodeCount() const;
+
+};
+
+#endif /* SRC_CPP_HEADER_COVERSOLVER_HPP_ */
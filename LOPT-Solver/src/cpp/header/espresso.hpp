@@ -0,0 +1,39 @@
+/*
+ * espresso.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_ESPRESSO_HPP_
+#define SRC_CPP_HEADER_ESPRESSO_HPP_
+
+#include <vector>
+#include "truthtable.hpp"
+#include "qmcp.hpp"
+
+typedef std::vector<QMCCube> cube_cover_t;
+
+class EspressoCover {
+
+private:
+	unsigned int variables = 0;
+	cube_cover_t onSet;
+	cube_cover_t offSet;
+	cube_cover_t cover;
+
+	void expand();
+	void irredundant();
+	void reduce();
+
+public:
+	void initialize(const TruthTable& table, unsigned int output);
+	void minimize();
+	void implicants(std::vector<QMCImplicant>& implicants) const;
+	const cube_cover_t& cubes() const;
+	unsigned int cost() const;
+	unsigned int variableCount() const;
+
+};
+
+#endif /* SRC_CPP_HEADER_ESPRESSO_HPP_ */
@@ -10,6 +10,8 @@
 #ifndef SRC_CPP_HEADER_FRAMEPRINT_HPP_
 #define SRC_CPP_HEADER_FRAMEPRINT_HPP_
 
+#include <mutex>
+
 void print_n(unsigned int n, const wchar_t* s);
 void pos_print(int up, int col);
 void color_print_f(unsigned int r, unsigned int g, unsigned int b);
@@ -19,5 +21,8 @@ void print_frame_top(unsigned int width);
 void print_frame_side(unsigned int width);
 void print_frame_div(unsigned int width);
 void print_frame_bottom(unsigned int width);
+std::unique_lock<std::recursive_mutex> print_lock();
+void set_quiet_print(bool quiet);
+void info_print(const wchar_t* format, ...);
 
 #endif /* SRC_CPP_HEADER_FRAMEPRINT_HPP_ */
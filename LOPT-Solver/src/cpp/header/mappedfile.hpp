@@ -0,0 +1,41 @@
+/*
+ * mappedfile.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_MAPPEDFILE_HPP_
+#define SRC_CPP_HEADER_MAPPEDFILE_HPP_
+
+#include <string>
+#include <string_view>
+
+/**
+ * An read only view of an file mapped into memory, the file is unmapped when the object is destroyed.
+ */
+class MappedFile {
+
+private:
+	const char* data = nullptr;
+	size_t length = 0;
+#ifdef _WIN32
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+#else
+	int fileDescriptor = -1;
+#endif
+
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+
+	bool open(const std::string& path);
+	void close();
+	std::string_view view() const;
+
+};
+
+#endif /* SRC_CPP_HEADER_MAPPEDFILE_HPP_ */
@@ -0,0 +1,43 @@
+/*
+ * mergekernel.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_MERGEKERNEL_HPP_
+#define SRC_CPP_HEADER_MERGEKERNEL_HPP_
+
+#include <vector>
+#include <memory_resource>
+#include <cstdint>
+
+// number of implicants of the second group tested against one implicant of the first group at once, one bit each in the result
+#define QMC_MERGE_BLOCK_SIZE 64
+
+/**
+ * The cubes and outputs of the implicants of an group as separate arrays,
+ * so that the merge kernel can load the same field of several implicants at once.
+ */
+struct QMCImplicantColumns {
+	std::pmr::vector<uint64_t> masks;
+	std::pmr::vector<uint64_t> values;
+	std::pmr::vector<uint64_t> outputs;
+
+	QMCImplicantColumns(std::pmr::memory_resource* arena = std::pmr::get_default_resource());
+	void push(uint64_t mask, uint64_t value, uint64_t outputs);
+	void reserve(unsigned int implicants);
+	unsigned int size() const;
+};
+
+enum QMCMergeKernel {
+	KERNEL_SCALAR = 0,
+	KERNEL_AVX2 = 1,
+	KERNEL_AVX512 = 2
+};
+
+uint64_t merge_partners(uint64_t mask, uint64_t value, uint64_t outputs, const QMCImplicantColumns& columns, unsigned int begin, unsigned int count);
+QMCMergeKernel merge_kernel();
+const char* merge_kernel_name();
+
+#endif /* SRC_CPP_HEADER_MERGEKERNEL_HPP_ */
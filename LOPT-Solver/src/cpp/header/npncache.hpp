@@ -0,0 +1,64 @@
+/*
+ * npncache.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_NPNCACHE_HPP_
+#define SRC_CPP_HEADER_NPNCACHE_HPP_
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <unordered_map>
+#include "qmcp.hpp"
+
+// functions up to this number of inputs are cached, their ON and DONT_CARE set fit into one 64 bit word each
+#define NPN_CACHE_MAX_INPUTS 6
+// no more functions are added once the cache holds this number of functions
+#define NPN_CACHE_MAX_ENTRIES 65536
+
+/**
+ * The transformation of an function into its canonical form.
+ * Input i of the function is input position[i] of the canonical form, negated if bit i of negated is set.
+ * If outputNegated is set, the function is the complement of the canonical form.
+ */
+struct NPNTransform {
+	unsigned int inputs = 0;
+	unsigned int position[NPN_CACHE_MAX_INPUTS] = {};
+	uint64_t negated = 0;
+	bool outputNegated = false;
+};
+
+struct NPNKey {
+	unsigned int inputs = 0;
+	uint64_t onSet = 0;
+	uint64_t dcSet = 0;
+	bool outputNegated = false;
+
+	bool operator==(const NPNKey& other) const = default;
+};
+
+struct NPNKeyHash {
+	size_t operator()(const NPNKey& key) const;
+};
+
+class NPNCache {
+
+private:
+	std::mutex mutex;
+	std::unordered_map<NPNKey, std::vector<QMCCube>, NPNKeyHash> terms;
+
+public:
+	static bool supports(unsigned int inputs);
+	static NPNKey canonicalize(unsigned int inputs, uint64_t onSet, uint64_t dcSet, NPNTransform& transform);
+	static QMCCube transformCube(const QMCCube& cube, const NPNTransform& transform, bool toCanonical);
+
+	bool find(const NPNKey& key, const NPNTransform& transform, std::vector<QMCImplicant>& finalTerm);
+	void insert(const NPNKey& key, const NPNTransform& transform, const std::vector<QMCImplicant>& finalTerm);
+	size_t size();
+
+};
+
+#endif /* SRC_CPP_HEADER_NPNCACHE_HPP_ */
@@ -0,0 +1,21 @@
+/*
+ * plaformat.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_PLAFORMAT_HPP_
+#define SRC_CPP_HEADER_PLAFORMAT_HPP_
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "truthtable.hpp"
+#include "qmcp.hpp"
+
+bool is_pla_file(const std::string& path);
+bool parse_pla(std::string_view plaStr, std::vector<TriStateBool>& values, unsigned int& inputs, unsigned int& outputs, TriStateBool& undefinedValue);
+void format_pla(const std::vector<std::vector<QMCImplicant>>& finalTerms, const std::vector<bool>& complemented, unsigned int inputs, std::wstring& out);
+
+#endif /* SRC_CPP_HEADER_PLAFORMAT_HPP_ */
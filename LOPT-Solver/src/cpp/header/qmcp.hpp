@@ -12,20 +12,65 @@
 #include <set>
 #include <map>
 #include <optional>
-#include "kvm.hpp"
+#include <cstdint>
+#include <unordered_set>
+#include <memory_resource>
+#include "truthtable.hpp"
+#include "bitset.hpp"
+#include "threadpool.hpp"
+#include "coversolver.hpp"
+#include "mergekernel.hpp"
+
+/**
+ * Packed representation of the variable states of an implicant.
+ * Bit i of the mask is set if input i is relevant (not DONT_CARE), bit i of the value holds its state.
+ * Value bits of irrelevant inputs are always kept zero, so that two cubes can be compared word by word.
+ */
+struct QMCCube {
+	uint64_t value = 0;
+	uint64_t mask = 0;
+
+	bool operator==(const QMCCube& other) const = default;
+};
+
+struct QMCCubeHash {
+	size_t operator()(const QMCCube& cube) const;
+};
+
+#define QMC_MAX_VARIABLES 64
+// the outputs of an implicant are stored as bit mask, this limits the number of outputs solved together
+#define QMC_MAX_OUTPUTS 64
+
+/**
+ * An minterm of the function, which has to be covered by the prime implicants.
+ * When solving multiple outputs together, the same state is an separate minterm for each output it is TRUE for.
+ */
+struct QMCMinterm {
+	unsigned int id;
+	uint64_t state;
+	unsigned int output = 0;
+};
 
 class QMCImplicant {
 
 private:
-	std::vector<TriStateBool> states;
-	std::vector<unsigned int> minterms;
+	QMCCube states;
+	uint64_t outputs = 1;
+	unsigned int variables = 0;
+	unsigned int minterms = 0;
 	bool prime = true;
 
 public:
-	void initialize(KVMap& map, unsigned int column, unsigned int row);
-	std::optional<QMCImplicant> tryMerge(const QMCImplicant& implicant);
-	const std::vector<TriStateBool>& variableStates() const;
-	const std::vector<unsigned int>& mintermSet() const;
+	void initialize(uint64_t state, unsigned int variables, bool dontCare);
+	void initialize(uint64_t state, unsigned int variables, uint64_t outputs, bool dontCare);
+	void initialize(const QMCCube& cube, unsigned int variables);
+	std::optional<QMCImplicant> tryMerge(const QMCImplicant& implicant) const;
+	const QMCCube& variableCube() const;
+	uint64_t outputMask() const;
+	bool coversOutput(unsigned int output) const;
+	TriStateBool variableState(unsigned int input) const;
+	unsigned int mintermCount() const;
+	bool covers(const QMCMinterm& minterm) const;
 	unsigned int variableCount() const;
 	unsigned int inputsTrueCount() const;
 	unsigned int relevantInputCount() const;
@@ -37,51 +82,134 @@ public:
 
 };
 
+// number of implicants of the first group of an pair which are merged within one task
+#define QMC_MERGE_TASK_SIZE 256
+
+struct QMCMergeResult {
+	uint64_t attempts = 0;
+	std::vector<QMCImplicant> merged;
+	std::vector<bool> mergedFirst;
+	std::vector<bool> mergedSecond;
+};
+
+struct QMCImplicantKey {
+	QMCCube cube;
+	uint64_t outputs;
+
+	bool operator==(const QMCImplicantKey& other) const = default;
+};
+
+struct QMCImplicantKeyHash {
+	size_t operator()(const QMCImplicantKey& key) const;
+};
+
+/**
+ * An group of implicants with the same number of TRUE inputs within one stage.
+ * All its containers allocate from the arena of the stack it belongs to.
+ */
 class QMCImplicantSet {
 
 private:
-	std::vector<QMCImplicant> implicants;
+	std::pmr::vector<QMCImplicant> implicants;
+	std::pmr::unordered_set<QMCImplicantKey, QMCImplicantKeyHash> index;
+	// the cubes and outputs again as columns for the merge kernel
+	QMCImplicantColumns columns;
 
 public:
-	void add(const QMCImplicant& implicant);
-	bool tryMerge(QMCImplicantSet& implicantSet, std::vector<QMCImplicantSet>& targetVector);
+	QMCImplicantSet(std::pmr::memory_resource* arena = std::pmr::get_default_resource());
+
+	bool add(const QMCImplicant& implicant);
+	void merge(const QMCImplicantSet& implicantSet, unsigned int begin, unsigned int end, QMCMergeResult& result) const;
+	void markMerged(const std::vector<bool>& merged, unsigned int begin);
+	void reserve(unsigned int implicants);
+	unsigned int size() const;
 	unsigned int variableCount() const;
-	const std::vector<QMCImplicant>& implicantSet() const;
+	const std::pmr::vector<QMCImplicant>& implicantSet() const;
 
 };
 
 typedef std::optional<std::reference_wrapper<const QMCImplicantSet>> QMCImplicantSetOpt;
 
+/**
+ * Counters of the work done while searching the prime implicants, only used for the solver statistics.
+ */
+struct QMCStackCounters {
+	uint64_t mergeAttempts = 0;
+	uint64_t merges = 0;
+	uint64_t duplicates = 0;
+};
+
 class QMCStack {
 
 private:
-	std::vector<unsigned int> minterms;
-	std::vector<std::vector<QMCImplicantSet>> stages;
+	// the implicants of all stages are only released together, when the stack is destroyed or initialized again
+	std::pmr::monotonic_buffer_resource arena;
+	std::pmr::vector<std::pmr::vector<QMCImplicantSet>> stages;
+	// the result buffers of the merge tasks are kept, so that later stages reuse their memory
+	std::vector<QMCMergeResult> mergeResults;
+	std::vector<QMCMinterm> minterms;
+	QMCStackCounters counters;
+
+	std::pmr::vector<QMCImplicantSet>& addStage(unsigned int sets);
 
 public:
-	void initialize(KVMap& map);
-	bool tryMerge();
+	QMCStack();
+
+	void initialize(const TruthTable& table, unsigned int output);
+	void initialize(const TruthTable& table);
+	bool tryMerge(ThreadPool* pool = nullptr);
 	QMCImplicantSetOpt implicantSetFor(unsigned int stage, unsigned int numberOfOnes) const;
 	unsigned int groupImplicantCount(unsigned int numberOfOnes) const;
+	const std::vector<QMCMinterm>& mintermSet() const;
 	unsigned int variableCount() const;
 	unsigned int stageCount() const;
+	const QMCStackCounters& workCounters() const;
 
 };
 
+enum QMCCoverMethod {
+	BRANCH_AND_BOUND = 0,
+	PETRICK = 1
+};
+
+/**
+ * Counters of the search for the optimal primes, only the ones of the used cover method are filled in.
+ */
+struct QMCCoverCounters {
+	uint64_t searchNodes = 0;
+	uint64_t petrickSums = 0;
+	uint64_t petrickProducts = 0;
+	uint64_t petrickPeakProducts = 0;
+};
+
 class QMCPrimeChart {
 
 private:
 	std::vector<QMCImplicant> primes;
-	std::vector<unsigned int> minterms;
+	std::vector<QMCMinterm> minterms;
+	std::vector<BitSet> coverage;
+
+	void updateCoverage();
+	void removeEntries(const BitSet& removedPrimes, const BitSet& removedMinterms);
+	void findOptimalPrimesPetrick(std::vector<QMCImplicant>& optimalPrimes, QMCCoverCounters* counters) const;
+	void findOptimalPrimesBranchAndBound(std::vector<QMCImplicant>& optimalPrimes, QMCCoverCounters* counters) const;
 
 public:
 	void initialize(const QMCStack& stack);
-	void extractEPIs(std::vector<QMCImplicant>& essentialPrimes);
-	void findOptimalPrimes(std::vector<QMCImplicant>& optimalPrimes) const;
+	void initialize(const std::vector<QMCImplicant>& primes, const std::vector<QMCMinterm>& minterms);
+	unsigned int extractEPIs(std::vector<QMCImplicant>& essentialPrimes);
+	unsigned int removeDominatedPrimes();
+	unsigned int removeDominatingMinterms();
+	unsigned int reduce(std::vector<QMCImplicant>& essentialPrimes);
+	void findOptimalPrimes(std::vector<QMCImplicant>& optimalPrimes, QMCCoverMethod method = QMCCoverMethod::BRANCH_AND_BOUND, QMCCoverCounters* counters = nullptr) const;
 	const std::vector<QMCImplicant>& primeImplicants() const;
-	const std::vector<unsigned int>& mintermIds() const;
+	const std::vector<QMCMinterm>& mintermSet() const;
+	const BitSet& primeCoverage(unsigned int prime) const;
+	bool covers(unsigned int prime, unsigned int minterm) const;
 	unsigned int variableCount() const;
 
+	static void selectOutputTerm(const std::vector<QMCImplicant>& primes, const std::vector<QMCMinterm>& minterms, unsigned int output, std::vector<QMCImplicant>& outputTerm);
+
 };
 
 #endif /* SRC_CPP_HEADER_QMCP_HPP_ */
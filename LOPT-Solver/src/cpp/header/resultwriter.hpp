@@ -0,0 +1,26 @@
+/*
+ * resultwriter.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_RESULTWRITER_HPP_
+#define SRC_CPP_HEADER_RESULTWRITER_HPP_
+
+#include <vector>
+#include <string>
+#include "qmcp.hpp"
+
+enum ResultFormat {
+	FRAME = 0,
+	TEXT = 1,
+	JSON = 2,
+	PLA = 3
+};
+
+void format_bool_term(const std::vector<QMCImplicant>& term, std::wstring& out);
+void format_results(const std::vector<std::vector<QMCImplicant>>& finalTerms, const std::vector<bool>& complemented, unsigned int inputs, ResultFormat format, std::wstring& out);
+void write_results(const std::vector<std::vector<QMCImplicant>>& finalTerms, const std::vector<bool>& complemented, unsigned int inputs, ResultFormat format);
+
+#endif /* SRC_CPP_HEADER_RESULTWRITER_HPP_ */
@@ -0,0 +1,40 @@
+/*
+ * server.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_SERVER_HPP_
+#define SRC_CPP_HEADER_SERVER_HPP_
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include "solver.hpp"
+
+/**
+ * An cache of formatted results, keyed by the request options and the table payload.
+ * The oldest entries are removed once the total size of the keys and results exceeds the capacity.
+ */
+class ResultCache {
+
+private:
+	std::mutex mutex;
+	size_t capacity;
+	size_t size = 0;
+	std::unordered_map<std::string, std::string> results;
+	std::deque<std::string> insertionOrder;
+
+public:
+	ResultCache(size_t capacity);
+
+	bool find(const std::string& key, std::string& result);
+	void insert(const std::string& key, const std::string& result);
+
+};
+
+bool run_server(const std::string& socketPath, const SolverOptions& options, size_t cacheCapacity);
+
+#endif /* SRC_CPP_HEADER_SERVER_HPP_ */
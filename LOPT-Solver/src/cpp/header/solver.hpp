@@ -0,0 +1,56 @@
+/*
+ * solver.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_SOLVER_HPP_
+#define SRC_CPP_HEADER_SOLVER_HPP_
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include "truthtable.hpp"
+#include "qmcp.hpp"
+#include "threadpool.hpp"
+#include "solverstats.hpp"
+#include "resultwriter.hpp"
+#include "npncache.hpp"
+
+enum SolverEngine {
+	QMC = 0,
+	ESPRESSO = 1,
+	BDD = 2,
+	ZDD = 3
+};
+
+struct SolverOptions {
+	bool verbose = false;
+	unsigned int jobs = 1;
+	QMCCoverMethod coverMethod = QMCCoverMethod::BRANCH_AND_BOUND;
+	SolverEngine engine = SolverEngine::QMC;
+	bool sharedTerms = false;
+	bool stats = false;
+	bool quiet = false;
+	ResultFormat format = ResultFormat::FRAME;
+};
+
+/**
+ * An output which has the same function as an earlier output, or the complement of it, and is not solved again.
+ */
+struct OutputAlias {
+	int source = -1;
+	bool complement = false;
+};
+
+std::unique_ptr<TruthTable> load_table(const std::string& tableFilePath, unsigned int inputs, unsigned int outputs, const SolverOptions& options);
+std::unique_ptr<TruthTable> parse_table(std::string_view tableStr, bool pla, unsigned int inputs, unsigned int outputs);
+bool check_table(const TruthTable& table, const SolverOptions& options);
+void find_output_aliases(const TruthTable& table, std::vector<OutputAlias>& aliases);
+void solve_output(const TruthTable& table, unsigned int o, const SolverOptions& options, std::vector<QMCImplicant>& finalTerm, ThreadPool* mergePool, OutputStats* stats, NPNCache* cache);
+void solve_shared(const TruthTable& table, const SolverOptions& options, std::vector<std::vector<QMCImplicant>>& finalTerms, ThreadPool* mergePool, OutputStats* stats);
+void solve_table(const TruthTable& table, const SolverOptions& options, std::vector<std::vector<QMCImplicant>>& finalTerms, std::vector<bool>& complemented, std::vector<OutputStats>* stats, ThreadPool* pool, NPNCache* cache);
+
+#endif /* SRC_CPP_HEADER_SOLVER_HPP_ */
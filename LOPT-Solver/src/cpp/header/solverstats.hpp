@@ -0,0 +1,67 @@
+/*
+ * solverstats.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_SOLVERSTATS_HPP_
+#define SRC_CPP_HEADER_SOLVERSTATS_HPP_
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include "qmcp.hpp"
+
+enum SolverPhase {
+	PHASE_INITIALIZE = 0,
+	PHASE_PRIMES = 1,
+	PHASE_CHART = 2,
+	PHASE_REDUCE = 3,
+	PHASE_SELECT = 4,
+	PHASE_COUNT = 5
+};
+
+/**
+ * The statistics of solving one output, or all outputs together when using shared terms (output = -1).
+ * Outputs which reuse the terms of an other output (source) or of the function cache have no statistics of their own.
+ */
+struct OutputStats {
+	int output = 0;
+	std::vector<std::vector<unsigned int>> groupSizes;
+	QMCStackCounters stackCounters;
+	QMCCoverCounters coverCounters;
+	unsigned int bddNodes = 0;
+	unsigned int zddNodes = 0;
+	double implicitPrimes = 0;
+	unsigned int chartPrimes = 0;
+	unsigned int chartMinterms = 0;
+	unsigned int essentialPrimes = 0;
+	unsigned int corePrimes = 0;
+	unsigned int coreMinterms = 0;
+	unsigned int terms = 0;
+	int source = -1;
+	bool complement = false;
+	bool cacheHit = false;
+	double phaseTimes[PHASE_COUNT] = {};
+};
+
+class PhaseTimer {
+
+private:
+	OutputStats* stats;
+	std::chrono::steady_clock::time_point start;
+
+public:
+	PhaseTimer(OutputStats* stats);
+
+	void restart();
+	void finish(SolverPhase phase);
+
+};
+
+void collect_stack_stats(const QMCStack& stack, OutputStats& stats);
+uint64_t peak_memory_usage();
+void print_solver_stats(const std::vector<OutputStats>& stats, double totalTime);
+
+#endif /* SRC_CPP_HEADER_SOLVERSTATS_HPP_ */
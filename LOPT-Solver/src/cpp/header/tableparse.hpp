@@ -0,0 +1,18 @@
+/*
+ * tableparse.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_TABLEPARSE_HPP_
+#define SRC_CPP_HEADER_TABLEPARSE_HPP_
+
+#include <string_view>
+#include <vector>
+#include "truthtable.hpp"
+
+TriStateBool parse_cell(std::string_view cell);
+bool parse_truthtable(std::string_view tableStr, std::vector<TriStateBool>& values, size_t& width);
+
+#endif /* SRC_CPP_HEADER_TABLEPARSE_HPP_ */
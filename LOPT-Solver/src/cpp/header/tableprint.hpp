@@ -19,6 +19,6 @@ void print_kvmap(const KVMap& map);
 void print_qmcstack(const QMCStack& stack);
 void print_qmcchart(const QMCPrimeChart& chart);
 void print_bool_term(const std::vector<QMCImplicant>& term);
-void print_result_table(const std::vector<std::vector<QMCImplicant>>& finalTerms);
+void print_result_table(const std::vector<std::vector<QMCImplicant>>& finalTerms, const std::vector<bool>& complemented);
 
 #endif /* SRC_CPP_HEADER_TABLEPRINT_HPP_ */
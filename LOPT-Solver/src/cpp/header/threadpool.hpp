@@ -0,0 +1,45 @@
+/*
+ * threadpool.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_THREADPOOL_HPP_
+#define SRC_CPP_HEADER_THREADPOOL_HPP_
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+class ThreadPool {
+
+private:
+	std::vector<std::thread> workers;
+	std::queue<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable taskAvailable;
+	std::condition_variable tasksCompleted;
+	unsigned int activeTasks = 0;
+	bool stopping = false;
+	std::exception_ptr failure;
+
+	void workerLoop();
+
+public:
+	ThreadPool(unsigned int threads);
+	~ThreadPool();
+
+	void submit(std::function<void()> task);
+	void wait();
+	unsigned int threadCount() const;
+
+	static unsigned int defaultThreadCount();
+
+};
+
+#endif /* SRC_CPP_HEADER_THREADPOOL_HPP_ */
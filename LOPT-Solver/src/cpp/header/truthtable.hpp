@@ -9,11 +9,28 @@
 #define SRC_CPP_HEADER_TRUTHTABLE_HPP_
 
 #include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "bitset.hpp"
 
 enum TriStateBool {
 	FALSE = 0,
 	TRUE = 1,
-	DONT_CARE = 2
+	DONT_CARE = 2,
+	// only used for output cells, the row does not define this output and the following rows are checked
+	UNDEFINED = 3
+};
+
+// up to this number of inputs, fully defined rows are indexed by an direct addressed array instead of an hash map
+#define TRUTHTABLE_DIRECT_INDEX_MAX_INPUTS 24
+// the direct addressed array is only used if at least one in this many states has an row, sparse tables (like PLA files) use the hash map
+#define TRUTHTABLE_DIRECT_INDEX_MAX_SPARSITY 16
+// outputSets() addresses all states of the inputs with an unsigned int, larger tables can only be solved without enumerating them
+#define TRUTHTABLE_MAX_ENUMERATED_INPUTS 30
+
+struct TruthTableTrieNode {
+	unsigned int children[3] = { 0, 0, 0 };
+	unsigned int row;
 };
 
 class TruthTable {
@@ -22,13 +39,30 @@ private:
 	unsigned int inputs;
 	unsigned int outputs;
 	std::vector<TriStateBool> data;
+	TriStateBool undefinedValue;
+	bool undefinedOutputs = false;
+
+	bool indexed = false;
+	std::vector<unsigned int> stateIndex;
+	std::unordered_map<uint64_t, unsigned int> stateMap;
+	std::vector<TruthTableTrieNode> cubeTrie;
+
+	void buildIndex();
+	unsigned int findLinear(TriStateBool* inputs) const;
 
 public:
-	TruthTable(std::vector<TriStateBool>& tableData, unsigned int inputs, unsigned int outputs);
+	TruthTable(std::vector<TriStateBool>& tableData, unsigned int inputs, unsigned int outputs, TriStateBool undefinedValue = TriStateBool::DONT_CARE);
+	TruthTable(std::vector<TriStateBool>&& tableData, unsigned int inputs, unsigned int outputs, TriStateBool undefinedValue = TriStateBool::DONT_CARE);
 
 	unsigned int find(TriStateBool* inputs) const;
+	unsigned int find(uint64_t state) const;
 	TriStateBool input(unsigned int state, unsigned int input) const;
 	TriStateBool output(unsigned int state, unsigned int output) const;
+	void outputSets(unsigned int output, BitSet& onSet, BitSet& dcSet) const;
+	TriStateBool undefinedStateValue() const;
+	bool hasUndefinedOutputs() const;
+	uint64_t outputFingerprint(unsigned int output, bool complement) const;
+	bool outputMatches(unsigned int output, unsigned int other, bool complement) const;
 
 	unsigned int inputCount() const;
 	unsigned int outputCount() const;
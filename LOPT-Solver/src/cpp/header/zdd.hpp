@@ -0,0 +1,111 @@
+/*
+ * zdd.hpp
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#ifndef SRC_CPP_HEADER_ZDD_HPP_
+#define SRC_CPP_HEADER_ZDD_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+#include "qmcp.hpp"
+#include "bdd.hpp"
+
+// nodes are referenced by their index in the node table, the first two nodes are the empty set and the set containing only the empty cube
+typedef unsigned int zdd_node_t;
+#define ZDD_EMPTY 0
+#define ZDD_BASE 1
+
+enum ZDDOperation {
+	ZDD_UNION = 0,
+	ZDD_INTERSECTION = 1,
+	ZDD_DIFFERENCE = 2,
+	// the cubes containing an variable, only used by subset()
+	ZDD_SUBSET = 3
+};
+
+struct ZDDOperationKey {
+	ZDDOperation operation;
+	zdd_node_t a;
+	zdd_node_t b;
+
+	bool operator==(const ZDDOperationKey& other) const = default;
+};
+
+struct ZDDOperationKeyHash {
+	size_t operator()(const ZDDOperationKey& key) const;
+};
+
+/**
+ * An table of zero-suppressed decision diagram nodes, each diagram is an set of cubes.
+ * Each input has two variables, 2 * i for the literal of the input being TRUE and 2 * i + 1 for it being FALSE.
+ * The nodes are stored like BDD nodes, with the low branch for the cubes without the literal and the high branch for the cubes with it.
+ */
+class ZDDManager {
+
+private:
+	unsigned int inputs;
+	std::vector<BDDNode> nodes;
+	std::unordered_map<BDDNode, zdd_node_t, BDDNodeHash> uniqueTable;
+	std::unordered_map<ZDDOperationKey, zdd_node_t, ZDDOperationKeyHash> computedTable;
+	std::unordered_map<zdd_node_t, double> countTable;
+
+	void cubes(zdd_node_t set, QMCCube cube, std::vector<QMCCube>& cubes) const;
+	bool findCube(zdd_node_t set, uint64_t state, QMCCube& cube, std::unordered_set<zdd_node_t>& dead) const;
+
+public:
+	ZDDManager(unsigned int inputs);
+
+	zdd_node_t makeNode(unsigned int variable, zdd_node_t low, zdd_node_t high);
+	zdd_node_t apply(ZDDOperation operation, zdd_node_t a, zdd_node_t b);
+	zdd_node_t subset(zdd_node_t set, unsigned int variable);
+	zdd_node_t cube(const QMCCube& cube);
+	bool containingCube(zdd_node_t set, uint64_t state, QMCCube& cube) const;
+	const BDDNode& node(zdd_node_t set) const;
+	double count(zdd_node_t set);
+	void cubes(zdd_node_t set, std::vector<QMCCube>& cubes) const;
+	unsigned int nodeCount() const;
+
+};
+
+/**
+ * An prime chart in which the primes are an ZDD and the minterms an BDD, so that neither has to be enumerated.
+ * The essential primes are found implicitly as well, only they and the primes of the cyclic core are returned as cubes.
+ */
+class ImplicitPrimeChart {
+
+private:
+	BDDManager& bdd;
+	ZDDManager zdd;
+	zdd_node_t primes = ZDD_EMPTY;
+	bdd_node_t minterms = BDD_FALSE;
+	std::unordered_map<bdd_node_t, zdd_node_t> primeTable;
+	std::unordered_map<uint64_t, zdd_node_t> intersectTable;
+	std::unordered_map<uint64_t, std::pair<bdd_node_t, bdd_node_t>> coverageTable;
+
+	void split(zdd_node_t cubes, unsigned int input, zdd_node_t& none, zdd_node_t& positive, zdd_node_t& negative) const;
+	zdd_node_t primeSet(bdd_node_t function);
+	zdd_node_t intersecting(zdd_node_t cubes, bdd_node_t function);
+	std::pair<bdd_node_t, bdd_node_t> coverage(zdd_node_t cubes, bdd_node_t states);
+	unsigned int extractEPIs(std::vector<QMCImplicant>& essentialPrimes);
+	bool removeDominatedPrimes();
+	bool removeDominatingMinterms();
+
+public:
+	ImplicitPrimeChart(BDDManager& bdd);
+
+	void initialize(bdd_node_t onSet, bdd_node_t dcSet);
+	unsigned int reduce(std::vector<QMCImplicant>& essentialPrimes);
+	void primeImplicants(std::vector<QMCCube>& primes) const;
+	double primeCount();
+	bdd_node_t mintermSet() const;
+	unsigned int nodeCount() const;
+
+};
+
+#endif /* SRC_CPP_HEADER_ZDD_HPP_ */
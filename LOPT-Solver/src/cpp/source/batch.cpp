@@ -0,0 +1,244 @@
+/*
+ * batch.cpp
+ *
+ * Batch mode of the solver, solves many tables within one process.
+ *
+ * The tables are given as an directory (all .txt and .pla files in it) or as an manifest file.
+ * The manifest contains one table per line, optionally followed by -i and/or -o for that table, # starts an comment.
+ * Relative paths in the manifest are relative to the directory of the manifest.
+ *
+ * The tables are distributed over an thread pool, each table is solved by one thread.
+ * No progress is printed for the individual tables, the results are either written into one file per table
+ * in the output directory, or printed in the order of the tables once all of them are completed.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <stdio.h>
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include "batch.hpp"
+#include "frameprint.hpp"
+#include "threadpool.hpp"
+#include "mappedfile.hpp"
+#include "plaformat.hpp"
+
+bool collect_batch_tables(const std::string& source, unsigned int inputs, unsigned int outputs, std::vector<BatchTable>& tables)
+{
+
+	std::error_code error;
+	if (std::filesystem::is_directory(source, error))
+	{
+		// sort the files, so that the order of the results does not depend on the file system
+		std::vector<std::string> files;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(source, error))
+		{
+			if (!entry.is_regular_file()) continue;
+			std::string extension = entry.path().extension().string();
+			if (extension == ".txt" || is_pla_file(entry.path().string()))
+				files.push_back(entry.path().string());
+		}
+		std::sort(files.begin(), files.end());
+		for (const std::string& file : files)
+			tables.push_back({ file, inputs, outputs });
+		return !error;
+	}
+
+	MappedFile manifest;
+	if (!manifest.open(source))
+	{
+		wprintf(L"[!] failed to open batch manifest or directory: %s\n", source.c_str());
+		return false;
+	}
+
+	std::filesystem::path base = std::filesystem::path(source).parent_path();
+	std::string_view manifestStr = manifest.view();
+	size_t line = 0;
+	size_t pos = 0;
+	while (pos < manifestStr.size())
+	{
+
+		size_t lineEnd = manifestStr.find('\n', pos);
+		if (lineEnd == std::string_view::npos) lineEnd = manifestStr.size();
+		std::string_view lineStr = manifestStr.substr(pos, lineEnd - pos);
+		pos = lineEnd + 1;
+		line++;
+
+		// split the line into words, the first one is the table path
+		std::vector<std::string> words;
+		size_t comment = lineStr.find('#');
+		if (comment != std::string_view::npos) lineStr = lineStr.substr(0, comment);
+		for (size_t begin = lineStr.find_first_not_of(" \t\r"); begin != std::string_view::npos; )
+		{
+			size_t end = lineStr.find_first_of(" \t\r", begin);
+			if (end == std::string_view::npos) end = lineStr.size();
+			words.emplace_back(lineStr.substr(begin, end - begin));
+			begin = lineStr.find_first_not_of(" \t\r", end);
+		}
+		if (words.empty()) continue;
+
+		BatchTable table = { words[0], inputs, outputs };
+		if (std::filesystem::path(table.path).is_relative())
+			table.path = (base / table.path).string();
+		// an invalid option only fails the table of its line, the other tables are still solved
+		for (size_t w = 1; w < words.size() && !table.invalid; w++)
+		{
+			if (words[w] != "-i" && words[w] != "-o")
+			{
+				wprintf(L"[!] manifest line %zu: unknown option %s!\n", line, words[w].c_str());
+				table.invalid = true;
+				break;
+			}
+			if (w + 1 >= words.size())
+			{
+				wprintf(L"[!] manifest line %zu: missing value for %s!\n", line, words[w].c_str());
+				table.invalid = true;
+				break;
+			}
+			unsigned int& value = words[w] == "-i" ? table.inputs : table.outputs;
+			const std::string& number = words[w + 1];
+			std::from_chars_result result = std::from_chars(number.data(), number.data() + number.size(), value);
+			if (result.ec != std::errc() || result.ptr != number.data() + number.size())
+			{
+				wprintf(L"[!] manifest line %zu: invalid value for %s: %s\n", line, words[w].c_str(), number.c_str());
+				table.invalid = true;
+			}
+			w++;
+		}
+		tables.push_back(table);
+
+	}
+	return true;
+
+}
+
+std::string result_file_path(const std::string& tablePath, const std::string& outputDirectory, ResultFormat format)
+{
+	std::string extension = format == ResultFormat::JSON ? ".json" : format == ResultFormat::PLA ? ".pla" : ".txt";
+	return (std::filesystem::path(outputDirectory) / (std::filesystem::path(tablePath).stem().string() + ".result" + extension)).string();
+}
+
+bool run_batch(const std::vector<BatchTable>& tables, const SolverOptions& options, const std::string& outputDirectory)
+{
+
+	// each table is solved by an single thread, the pool runs multiple tables at once instead
+	SolverOptions tableOptions = options;
+	tableOptions.jobs = 1;
+	tableOptions.quiet = true;
+	tableOptions.verbose = false;
+	tableOptions.stats = false;
+	if (tableOptions.format == ResultFormat::FRAME)
+		tableOptions.format = ResultFormat::TEXT;
+	set_quiet_print(true);
+
+	if (!outputDirectory.empty())
+	{
+		// the result file is named after the table, tables with the same name would overwrite each others results
+		std::map<std::string, unsigned int> resultPaths;
+		for (unsigned int t = 0; t < tables.size(); t++)
+		{
+			std::string resultPath = result_file_path(tables[t].path, outputDirectory, tableOptions.format);
+			auto entry = resultPaths.emplace(resultPath, t);
+			if (entry.second) continue;
+			wprintf(L"[!] the results of %s and %s would both be written to %s!\n", tables[entry.first->second].path.c_str(), tables[t].path.c_str(), resultPath.c_str());
+			return false;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(outputDirectory, error);
+	}
+
+	// small functions solved for one table are reused for all other tables
+	NPNCache cache;
+	std::vector<std::wstring> results(tables.size());
+	// not an vector<bool>, its elements are written concurrently by the pool threads
+	std::vector<char> solved(tables.size(), false);
+	auto solveTable = [&](unsigned int t) {
+
+		// the error of an invalid manifest line was already printed while collecting the tables
+		if (tables[t].invalid) return;
+
+		std::unique_ptr<TruthTable> table = load_table(tables[t].path, tables[t].inputs, tables[t].outputs, tableOptions);
+		if (!table || !check_table(*table, tableOptions))
+		{
+			wprintf(L"[!] failed to load table: %s\n", tables[t].path.c_str());
+			return;
+		}
+
+		std::vector<std::vector<QMCImplicant>> finalTerms;
+		std::vector<bool> complemented;
+		solve_table(*table, tableOptions, finalTerms, complemented, nullptr, nullptr, &cache);
+		format_results(finalTerms, complemented, table->inputCount(), tableOptions.format, results[t]);
+		solved[t] = true;
+
+		if (outputDirectory.empty()) return;
+
+		// the results only contain ASCII characters, so they can be written as narrow text
+		std::string resultPath = result_file_path(tables[t].path, outputDirectory, tableOptions.format);
+		std::ofstream resultFile(resultPath, std::ios::binary);
+		resultFile << std::string(results[t].begin(), results[t].end());
+		if (!resultFile)
+		{
+			wprintf(L"[!] failed to write result file: %s\n", resultPath.c_str());
+			solved[t] = false;
+		}
+		results[t].clear();
+
+	};
+
+	if (options.jobs == 1)
+	{
+		for (unsigned int t = 0; t < tables.size(); t++)
+			solveTable(t);
+	}
+	else
+	{
+		ThreadPool pool(options.jobs);
+		for (unsigned int t = 0; t < tables.size(); t++)
+			pool.submit([&solveTable, t]() { solveTable(t); });
+		pool.wait();
+	}
+
+	// print the results in the order of the tables, with one buffered write
+	unsigned int failed = std::count(solved.begin(), solved.end(), (char) false);
+	if (outputDirectory.empty())
+	{
+		std::wstring out;
+		bool json = tableOptions.format == ResultFormat::JSON;
+		if (json) out += L"{ \"tables\": [\n";
+		for (unsigned int t = 0; t < tables.size(); t++)
+		{
+			std::wstring path(tables[t].path.begin(), tables[t].path.end());
+			if (json)
+			{
+				out += t > 0 ? L",\n{ \"file\": \"" : L"{ \"file\": \"";
+				for (wchar_t c : path)
+				{
+					if (c == L'"' || c == L'\\') out += L'\\';
+					out += c;
+				}
+				out += L"\", \"result\": ";
+				out += solved[t] ? results[t] : L"null\n";
+				out += L"}";
+			}
+			else
+			{
+				out += L"== " + path + L"\n";
+				out += solved[t] ? results[t] : L"[!] failed\n";
+			}
+		}
+		if (json) out += L"\n] }\n";
+		fputws(out.c_str(), stdout);
+	}
+
+	// without an output directory the results are on stdout, an summary behind them would break JSON output
+	if (!options.quiet && !outputDirectory.empty())
+		wprintf(L"[i] batch completed: %zu tables, %u failed\n", tables.size(), failed);
+	fflush(stdout);
+	return failed == 0;
+
+}
@@ -0,0 +1,353 @@
+/*
+ * bdd.cpp
+ *
+ * Solver engine based on binary decision diagrams (BDDs), for functions with too many inputs to enumerate their minterms.
+ * The memory required depends on the size of the BDD and the number of primes, not on the number of inputs.
+ *
+ * The ON and DONT_CARE set of an output are built from the rows of the truth table, the first row defining an state wins.
+ * The prime implicants of ON + DONT_CARE are computed recursively on the BDD, for the top variable x of an function f:
+ *   primes(f) = primes(f0 * f1) + x' * (primes(f0) - primes(f0 * f1)) + x * (primes(f1) - primes(f0 * f1))
+ * where f0 and f1 are the functions for x = 0 and x = 1, the primes of each node are only computed once.
+ *
+ * The prime chart does not contain all minterms of the ON-set, only the ones required to find an cover of all of them.
+ * It starts with one minterm per prime, and minterms not covered by the cover of the chart are added until the cover is complete.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <unordered_set>
+#include "bdd.hpp"
+
+size_t BDDNodeHash::operator()(const BDDNode& node) const
+{
+	uint64_t key = (static_cast<uint64_t>(node.low) << 32 | node.high) * 0x9E3779B97F4A7C15ULL;
+	return std::hash<uint64_t>()(key ^ node.variable);
+}
+
+size_t BDDOperationKeyHash::operator()(const BDDOperationKey& key) const
+{
+	uint64_t value = (static_cast<uint64_t>(key.a) << 32 | key.b) * 0x9E3779B97F4A7C15ULL;
+	return std::hash<uint64_t>()(value ^ key.operation);
+}
+
+BDDManager::BDDManager(unsigned int variables)
+{
+	// the constants are below the last variable
+	this->variables = variables;
+	this->nodes.push_back({ variables, BDD_FALSE, BDD_FALSE });
+	this->nodes.push_back({ variables, BDD_TRUE, BDD_TRUE });
+}
+
+bdd_node_t BDDManager::makeNode(unsigned int variable, bdd_node_t low, bdd_node_t high)
+{
+	// an node with equal branches does not depend on its variable
+	if (low == high) return low;
+	BDDNode node = { variable, low, high };
+	auto entry = this->uniqueTable.try_emplace(node, this->nodes.size());
+	if (entry.second)
+		this->nodes.push_back(node);
+	return entry.first->second;
+}
+
+bdd_node_t BDDManager::cube(const QMCCube& cube)
+{
+	// built from the bottom up, so that each node only has to be created once
+	bdd_node_t node = BDD_TRUE;
+	for (unsigned int i = this->variables; i-- > 0; )
+	{
+		if (!(cube.mask & (1ULL << i))) continue;
+		node = (cube.value & (1ULL << i)) ? makeNode(i, BDD_FALSE, node) : makeNode(i, node, BDD_FALSE);
+	}
+	return node;
+}
+
+bdd_node_t BDDManager::apply(BDDOperation operation, bdd_node_t a, bdd_node_t b)
+{
+
+	switch (operation)
+	{
+	case BDD_AND:
+		if (a == BDD_FALSE || b == BDD_FALSE) return BDD_FALSE;
+		if (a == BDD_TRUE || a == b) return b;
+		if (b == BDD_TRUE) return a;
+		if (a > b) std::swap(a, b);
+		break;
+	case BDD_OR:
+		if (a == BDD_TRUE || b == BDD_TRUE) return BDD_TRUE;
+		if (a == BDD_FALSE || a == b) return b;
+		if (b == BDD_FALSE) return a;
+		if (a > b) std::swap(a, b);
+		break;
+	case BDD_AND_NOT:
+		if (a == BDD_FALSE || b == BDD_TRUE || a == b) return BDD_FALSE;
+		if (b == BDD_FALSE) return a;
+		break;
+	case BDD_COFACTOR:
+		// the variable and its value are encoded in b like in the key of the computed table
+		return cofactor(a, b / 2, b % 2);
+	}
+
+	BDDOperationKey key = { operation, a, b };
+	auto cached = this->computedTable.find(key);
+	if (cached != this->computedTable.end()) return cached->second;
+
+	// split both functions on the topmost variable of the two
+	BDDNode nodeA = this->nodes[a];
+	BDDNode nodeB = this->nodes[b];
+	unsigned int variable = std::min(nodeA.variable, nodeB.variable);
+	bdd_node_t a0 = nodeA.variable == variable ? nodeA.low : a;
+	bdd_node_t a1 = nodeA.variable == variable ? nodeA.high : a;
+	bdd_node_t b0 = nodeB.variable == variable ? nodeB.low : b;
+	bdd_node_t b1 = nodeB.variable == variable ? nodeB.high : b;
+	bdd_node_t low = apply(operation, a0, b0);
+	bdd_node_t high = apply(operation, a1, b1);
+
+	bdd_node_t result = makeNode(variable, low, high);
+	this->computedTable.emplace(key, result);
+	return result;
+
+}
+
+bdd_node_t BDDManager::cofactor(bdd_node_t function, unsigned int variable, bool value)
+{
+
+	BDDNode node = this->nodes[function];
+	if (node.variable > variable) return function;
+	if (node.variable == variable) return value ? node.high : node.low;
+
+	BDDOperationKey key = { BDDOperation::BDD_COFACTOR, function, variable * 2 + (value ? 1 : 0) };
+	auto cached = this->computedTable.find(key);
+	if (cached != this->computedTable.end()) return cached->second;
+
+	bdd_node_t low = cofactor(node.low, variable, value);
+	bdd_node_t high = cofactor(node.high, variable, value);
+	bdd_node_t result = makeNode(node.variable, low, high);
+	this->computedTable.emplace(key, result);
+	return result;
+
+}
+
+const BDDNode& BDDManager::node(bdd_node_t function) const
+{
+	return this->nodes[function];
+}
+
+bool BDDManager::findPath(bdd_node_t function, const QMCCube& cube, uint64_t& state, std::unordered_set<bdd_node_t>& dead) const
+{
+	if (function == BDD_TRUE) return true;
+	if (function == BDD_FALSE || dead.count(function)) return false;
+	const BDDNode& node = this->nodes[function];
+	uint64_t bit = 1ULL << node.variable;
+	if ((!(cube.mask & bit) || !(cube.value & bit)) && findPath(node.low, cube, state, dead))
+		return true;
+	if ((!(cube.mask & bit) || (cube.value & bit)) && findPath(node.high, cube, state, dead))
+	{
+		state |= bit;
+		return true;
+	}
+	dead.insert(function);
+	return false;
+}
+
+bool BDDManager::pickState(bdd_node_t function, const QMCCube& cube, uint64_t& state) const
+{
+	/**
+	 * follow any path to TRUE through the cube, the inputs not on the path take the value of the cube (or FALSE).
+	 * nodes without such an path are remembered, so that each node is visited only once.
+	 * this does not create any nodes, unlike intersecting the function with the cube first.
+	 */
+	std::unordered_set<bdd_node_t> dead;
+	state = 0;
+	if (!findPath(function, cube, state, dead)) return false;
+	state |= cube.value & cube.mask;
+	return true;
+}
+
+const std::vector<QMCCube>& BDDManager::primes(bdd_node_t function)
+{
+
+	auto cached = this->primeTable.find(function);
+	if (cached != this->primeTable.end()) return cached->second;
+
+	std::vector<QMCCube> result;
+	if (function == BDD_TRUE)
+	{
+		// the empty cube (all inputs DONT_CARE) is the only prime of TRUE
+		result.push_back({ 0, 0 });
+	}
+	else if (function != BDD_FALSE)
+	{
+		BDDNode node = this->nodes[function];
+		bdd_node_t both = apply(BDDOperation::BDD_AND, node.low, node.high);
+
+		// the primes not depending on the variable
+		result = primes(both);
+
+		/**
+		 * the primes of the cofactors which are not implied by both of them need the literal of the variable.
+		 * an prime of an cofactor implied by both of them is also an prime of both, so this is an lookup in the primes of both.
+		 */
+		std::unordered_set<QMCCube, QMCCubeHash> bothPrimes(result.begin(), result.end());
+		uint64_t bit = 1ULL << node.variable;
+		for (bool value : { false, true })
+		{
+			const std::vector<QMCCube>& cofactorPrimes = primes(value ? node.high : node.low);
+			for (const QMCCube& prime : cofactorPrimes)
+			{
+				if (bothPrimes.count(prime)) continue;
+				result.push_back({ prime.value | (value ? bit : 0), prime.mask | bit });
+			}
+		}
+	}
+
+	return this->primeTable.emplace(function, std::move(result)).first->second;
+
+}
+
+void BDDManager::primeImplicants(bdd_node_t function, std::vector<QMCCube>& primes)
+{
+	primes = this->primes(function);
+}
+
+unsigned int BDDManager::nodeCount() const
+{
+	return this->nodes.size();
+}
+
+unsigned int BDDManager::variableCount() const
+{
+	return this->variables;
+}
+
+BDDFunction::BDDFunction(unsigned int variables) : manager(variables) {}
+
+void BDDFunction::initialize(const TruthTable& table, unsigned int output)
+{
+
+	/**
+	 * like TruthTable::find(), the first row matching an state defines its value.
+	 * so each row only adds the states which are not already defined by an earlier row.
+	 */
+	unsigned int variables = table.inputCount();
+	bdd_node_t defined = BDD_FALSE;
+	this->onSet = BDD_FALSE;
+	this->dcSet = BDD_FALSE;
+	for (unsigned int s = 0; s < table.stateCount(); s++)
+	{
+		TriStateBool value = table.output(s, output);
+		if (value == TriStateBool::UNDEFINED) continue;
+
+		QMCCube rowCube;
+		for (unsigned int i = 0; i < variables; i++)
+		{
+			TriStateBool in = table.input(s, i);
+			if (in == TriStateBool::DONT_CARE) continue;
+			rowCube.mask |= 1ULL << i;
+			if (in == TriStateBool::TRUE) rowCube.value |= 1ULL << i;
+		}
+
+		bdd_node_t row = this->manager.cube(rowCube);
+		bdd_node_t added = this->manager.apply(BDDOperation::BDD_AND_NOT, row, defined);
+		if (value == TriStateBool::TRUE)
+			this->onSet = this->manager.apply(BDDOperation::BDD_OR, this->onSet, added);
+		else if (value == TriStateBool::DONT_CARE)
+			this->dcSet = this->manager.apply(BDDOperation::BDD_OR, this->dcSet, added);
+		defined = this->manager.apply(BDDOperation::BDD_OR, defined, row);
+	}
+
+	// states not defined in the table are DONT_CARE, or FALSE for tables read from cube formats
+	bdd_node_t undefined = this->manager.apply(BDDOperation::BDD_AND_NOT, BDD_TRUE, defined);
+	if (table.undefinedStateValue() == TriStateBool::DONT_CARE)
+		this->dcSet = this->manager.apply(BDDOperation::BDD_OR, this->dcSet, undefined);
+	else if (table.undefinedStateValue() == TriStateBool::TRUE)
+		this->onSet = this->manager.apply(BDDOperation::BDD_OR, this->onSet, undefined);
+
+}
+
+void BDDFunction::primeImplicants(std::vector<QMCImplicant>& primes)
+{
+
+	// the primes of ON + DONT_CARE, only the ones covering at least one TRUE state are needed
+	std::vector<QMCCube> cubes;
+	this->manager.primeImplicants(this->manager.apply(BDDOperation::BDD_OR, this->onSet, this->dcSet), cubes);
+
+	primes.clear();
+	this->primes.clear();
+	for (const QMCCube& cube : cubes)
+	{
+		uint64_t state;
+		if (!this->manager.pickState(this->onSet, cube, state)) continue;
+		primes.emplace_back().initialize(cube, this->manager.variableCount());
+		this->primes.push_back(cube);
+	}
+
+}
+
+void BDDFunction::sampleMinterms(const std::vector<QMCImplicant>& primes, std::vector<QMCMinterm>& minterms)
+{
+	// one minterm of the ON-set for each prime, the same minterm is only added once
+	minterms.clear();
+	std::unordered_set<uint64_t> states;
+	for (const QMCImplicant& prime : primes)
+	{
+		uint64_t state;
+		if (this->manager.pickState(this->onSet, prime.variableCube(), state) && states.insert(state).second)
+			minterms.push_back({ static_cast<unsigned int>(minterms.size()), state });
+	}
+}
+
+bool BDDFunction::uncoveredMinterms(const std::vector<QMCImplicant>& cover, std::vector<QMCMinterm>& minterms)
+{
+
+	bdd_node_t uncovered = this->onSet;
+	for (const QMCImplicant& implicant : cover)
+		uncovered = this->manager.apply(BDDOperation::BDD_AND_NOT, uncovered, this->manager.cube(implicant.variableCube()));
+	if (uncovered == BDD_FALSE) return false;
+
+	/**
+	 * the added minterms should require different primes, so after each minterm
+	 * the states covered by the primes covering it are not considered for the next ones.
+	 */
+	for (unsigned int added = 0; added < BDD_UNCOVERED_MINTERMS_PER_ROUND; added++)
+	{
+		uint64_t state;
+		if (!this->manager.pickState(uncovered, {}, state)) break;
+		minterms.push_back({ static_cast<unsigned int>(minterms.size()), state });
+		for (const QMCCube& prime : this->primes)
+			if (((state ^ prime.value) & prime.mask) == 0)
+				uncovered = this->manager.apply(BDDOperation::BDD_AND_NOT, uncovered, this->manager.cube(prime));
+	}
+	return true;
+
+}
+
+void BDDFunction::restrictToCore(bdd_node_t onSet, const std::vector<QMCCube>& primes, std::vector<QMCImplicant>& implicants)
+{
+	// only the minterms and primes left after reducing the chart implicitly are used for the chart
+	this->onSet = onSet;
+	this->primes = primes;
+	implicants.clear();
+	for (const QMCCube& cube : primes)
+		implicants.emplace_back().initialize(cube, this->manager.variableCount());
+}
+
+BDDManager& BDDFunction::diagram()
+{
+	return this->manager;
+}
+
+bdd_node_t BDDFunction::onSetFunction() const
+{
+	return this->onSet;
+}
+
+bdd_node_t BDDFunction::dcSetFunction() const
+{
+	return this->dcSet;
+}
+
+unsigned int BDDFunction::nodeCount() const
+{
+	return this->manager.nodeCount();
+}
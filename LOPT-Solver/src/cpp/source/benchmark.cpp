@@ -0,0 +1,295 @@
+/*
+ * benchmark.cpp
+ *
+ * Benchmark mode of the solver.
+ * Generates reproducible truth tables and measures the time spent in the individual stages of the QMC solver.
+ *
+ * The tables are described by an short spec string "type:key=value,key=value", the following types are supported:
+ * - random: inputs, outputs, on (density of TRUE states), dc (density of DONT_CARE states), seed
+ * - adder: bits, the sum and carry of two unsigned numbers
+ * - comparator: bits, the less, equal and greater outputs for two unsigned numbers
+ * - mux: select, an multiplexer with the given number of select inputs
+ * The results are printed as JSON, with the minimum and mean time of each stage over all runs.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <stdio.h>
+#include <map>
+#include <memory>
+#include <random>
+#include <functional>
+#include <chrono>
+#include <algorithm>
+#include "benchmark.hpp"
+#include "tableparse.hpp"
+#include "truthtable.hpp"
+#include "kvm.hpp"
+#include "mergekernel.hpp"
+
+const char* BENCHMARK_STAGE_NAMES[STAGE_COUNT] = { "load", "kvmap", "merge", "chart", "reduce", "cover" };
+
+bool parse_spec(const std::string& spec, std::string& type, std::map<std::string, std::string>& params)
+{
+	size_t split = spec.find(':');
+	type = spec.substr(0, split);
+	if (split == std::string::npos) return true;
+
+	size_t pos = split + 1;
+	while (pos < spec.size())
+	{
+		size_t end = spec.find(',', pos);
+		if (end == std::string::npos) end = spec.size();
+		std::string param = spec.substr(pos, end - pos);
+		size_t equals = param.find('=');
+		if (equals == std::string::npos)
+		{
+			wprintf(L"[!] invalid benchmark parameter: %s\n", param.c_str());
+			return false;
+		}
+		params[param.substr(0, equals)] = param.substr(equals + 1);
+		pos = end + 1;
+	}
+	return true;
+}
+
+unsigned int spec_uint(const std::map<std::string, std::string>& params, const std::string& key, unsigned int defaultValue)
+{
+	auto param = params.find(key);
+	return param == params.end() ? defaultValue : std::stoul(param->second);
+}
+
+double spec_double(const std::map<std::string, std::string>& params, const std::string& key, double defaultValue)
+{
+	auto param = params.find(key);
+	return param == params.end() ? defaultValue : std::stod(param->second);
+}
+
+bool generate_table(const std::string& spec, BenchmarkTable& table)
+{
+
+	std::string type;
+	std::map<std::string, std::string> params;
+	if (!parse_spec(spec, type, params)) return false;
+
+	// the number of inputs and outputs of the table, and the function which fills in the outputs of one state
+	std::function<void(uint64_t, std::vector<char>&)> function;
+	if (type == "random")
+	{
+		table.inputs = spec_uint(params, "inputs", 8);
+		table.outputs = spec_uint(params, "outputs", 1);
+		double on = spec_double(params, "on", 0.5);
+		double dc = spec_double(params, "dc", 0.0);
+		unsigned int seed = spec_uint(params, "seed", 1);
+		std::string onText = params.count("on") ? params["on"] : "0.5";
+		std::string dcText = params.count("dc") ? params["dc"] : "0";
+		table.name = "random:inputs=" + std::to_string(table.inputs) + ",outputs=" + std::to_string(table.outputs) +
+				",on=" + onText + ",dc=" + dcText + ",seed=" + std::to_string(seed);
+
+		// the generator is created once per table, so the states are generated in order and the table is reproducible
+		auto generator = std::make_shared<std::mt19937_64>(seed);
+		function = [generator, on, dc](uint64_t, std::vector<char>& outputs) {
+			std::uniform_real_distribution<double> distribution(0.0, 1.0);
+			for (char& output : outputs)
+			{
+				double r = distribution(*generator);
+				output = r < dc ? 'X' : r < dc + on ? '1' : '0';
+			}
+		};
+	}
+	else if (type == "adder")
+	{
+		unsigned int bits = spec_uint(params, "bits", 4);
+		table.inputs = bits * 2;
+		table.outputs = bits + 1;
+		table.name = "adder:bits=" + std::to_string(bits);
+		function = [bits](uint64_t state, std::vector<char>& outputs) {
+			uint64_t mask = (1ULL << bits) - 1;
+			uint64_t sum = (state >> bits) + (state & mask);
+			for (unsigned int o = 0; o <= bits; o++)
+				outputs[o] = (sum & (1ULL << (bits - o))) ? '1' : '0';
+		};
+	}
+	else if (type == "comparator")
+	{
+		unsigned int bits = spec_uint(params, "bits", 4);
+		table.inputs = bits * 2;
+		table.outputs = 3;
+		table.name = "comparator:bits=" + std::to_string(bits);
+		function = [bits](uint64_t state, std::vector<char>& outputs) {
+			uint64_t a = state >> bits;
+			uint64_t b = state & ((1ULL << bits) - 1);
+			outputs[0] = a < b ? '1' : '0';
+			outputs[1] = a == b ? '1' : '0';
+			outputs[2] = a > b ? '1' : '0';
+		};
+	}
+	else if (type == "mux")
+	{
+		unsigned int select = spec_uint(params, "select", 2);
+		table.inputs = select + (1U << select);
+		table.outputs = 1;
+		table.name = "mux:select=" + std::to_string(select);
+		function = [select](uint64_t state, std::vector<char>& outputs) {
+			// the select inputs come first, followed by the data inputs with the first one as most significant bit
+			unsigned int data = 1U << select;
+			uint64_t selected = state >> data;
+			outputs[0] = (state & (1ULL << (data - 1 - selected))) ? '1' : '0';
+		};
+	}
+	else
+	{
+		wprintf(L"[!] unknown benchmark table type: %s\n", type.c_str());
+		return false;
+	}
+
+	if (table.inputs == 0 || table.inputs > BENCHMARK_MAX_INPUTS || table.outputs == 0)
+	{
+		wprintf(L"[!] invalid benchmark table size: %u inputs %u outputs, at most %u inputs supported\n", table.inputs, table.outputs, BENCHMARK_MAX_INPUTS);
+		return false;
+	}
+
+	// write all states of the table in the text format, with the first input as the most significant bit of the state
+	table.tableText.clear();
+	std::vector<char> outputs(table.outputs);
+	for (uint64_t state = 0; state < (1ULL << table.inputs); state++)
+	{
+		function(state, outputs);
+		for (unsigned int i = 0; i < table.inputs; i++)
+		{
+			table.tableText += (state & (1ULL << (table.inputs - 1 - i))) ? '1' : '0';
+			table.tableText += '\t';
+		}
+		for (unsigned int o = 0; o < table.outputs; o++)
+		{
+			table.tableText += outputs[o];
+			table.tableText += o + 1 < table.outputs ? '\t' : '\n';
+		}
+	}
+	return true;
+
+}
+
+void benchmark_suite(std::vector<std::string>& specs)
+{
+	specs.push_back("random:inputs=8,outputs=4,on=0.5,dc=0.1,seed=1");
+	specs.push_back("random:inputs=9,outputs=2,on=0.3,dc=0.2,seed=2");
+	specs.push_back("random:inputs=10,outputs=1,on=0.2,dc=0.3,seed=3");
+	specs.push_back("random:inputs=9,outputs=1,on=0.5,dc=0,seed=4");
+	specs.push_back("adder:bits=3");
+	specs.push_back("adder:bits=4");
+	specs.push_back("comparator:bits=4");
+	specs.push_back("mux:select=3");
+}
+
+bool run_benchmarks(const std::vector<std::string>& specs, unsigned int runs, QMCCoverMethod coverMethod, ThreadPool* mergePool)
+{
+
+	typedef std::chrono::steady_clock clock;
+	auto elapsed = [](clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	};
+
+	// the merge kernel depends on the CPU, it is reported so that results of different machines can be compared
+	wprintf(L"{\n  \"runs\": %u,\n  \"merge_kernel\": \"%s\",\n  \"benchmarks\": [", runs, merge_kernel_name());
+	for (unsigned int b = 0; b < specs.size(); b++)
+	{
+
+		BenchmarkTable benchTable;
+		if (!generate_table(specs[b], benchTable)) return false;
+
+		std::vector<std::vector<double>> stageTimes(STAGE_COUNT);
+		std::vector<double> totalTimes;
+		unsigned int terms = 0;
+		unsigned int literals = 0;
+		unsigned int rows = 0;
+		for (unsigned int run = 0; run < runs; run++)
+		{
+
+			std::vector<double> times(STAGE_COUNT, 0.0);
+
+			clock::time_point start = clock::now();
+			std::vector<TriStateBool> values;
+			size_t width = 0;
+			if (!parse_truthtable(benchTable.tableText, values, width)) return false;
+			TruthTable table(std::move(values), benchTable.inputs, benchTable.outputs);
+			times[LOAD] = elapsed(start);
+			rows = table.stateCount();
+
+			start = clock::now();
+			for (unsigned int o = 0; o < table.outputCount(); o++)
+				KVMap kvMap(table, o);
+			times[KVMAP] = elapsed(start);
+
+			terms = 0;
+			literals = 0;
+			for (unsigned int o = 0; o < table.outputCount(); o++)
+			{
+
+				// the initialization of the stack is included in the merge stage
+				start = clock::now();
+				QMCStack implicantStack;
+				implicantStack.initialize(table, o);
+				while (implicantStack.tryMerge(mergePool));
+				times[MERGE] += elapsed(start);
+
+				start = clock::now();
+				QMCPrimeChart chart;
+				chart.initialize(implicantStack);
+				times[CHART] += elapsed(start);
+
+				start = clock::now();
+				std::vector<QMCImplicant> finalTerm;
+				chart.reduce(finalTerm);
+				times[REDUCE] += elapsed(start);
+
+				start = clock::now();
+				if (chart.mintermSet().size() != 0)
+					chart.findOptimalPrimes(finalTerm, coverMethod);
+				times[COVER] += elapsed(start);
+
+				terms += finalTerm.size();
+				for (const QMCImplicant& implicant : finalTerm)
+					literals += implicant.relevantInputCount();
+
+			}
+
+			double total = 0;
+			for (unsigned int s = 0; s < STAGE_COUNT; s++)
+			{
+				stageTimes[s].push_back(times[s]);
+				total += times[s];
+			}
+			totalTimes.push_back(total);
+
+		}
+
+		auto printTimes = [](const std::vector<double>& times) {
+			double sum = 0;
+			for (double time : times)
+				sum += time;
+			wprintf(L"{ \"min_ms\": %.3f, \"mean_ms\": %.3f }", *std::min_element(times.begin(), times.end()), sum / times.size());
+		};
+
+		wprintf(L"%s\n    {\n", b > 0 ? "," : "");
+		wprintf(L"      \"name\": \"%s\",\n", benchTable.name.c_str());
+		wprintf(L"      \"inputs\": %u,\n      \"outputs\": %u,\n      \"rows\": %u,\n", benchTable.inputs, benchTable.outputs, rows);
+		wprintf(L"      \"terms\": %u,\n      \"literals\": %u,\n", terms, literals);
+		wprintf(L"      \"stages\": {\n");
+		for (unsigned int s = 0; s < STAGE_COUNT; s++)
+		{
+			wprintf(L"        \"%s\": ", BENCHMARK_STAGE_NAMES[s]);
+			printTimes(stageTimes[s]);
+			wprintf(L"%s\n", s + 1 < STAGE_COUNT ? "," : "");
+		}
+		wprintf(L"      },\n      \"total\": ");
+		printTimes(totalTimes);
+		wprintf(L"\n    }");
+		fflush(stdout);
+
+	}
+	wprintf(L"\n  ]\n}\n");
+	return true;
+
+}
@@ -0,0 +1,149 @@
+/*
+ * bitset.cpp
+ *
+ * An dynamically sized bit set.
+ *
+ * Used to store which minterms are covered by which prime implicants, so that unions and
+ * membership tests can be done on whole words instead of searching through lists.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <bit>
+#include <algorithm>
+#include "bitset.hpp"
+
+BitSet::BitSet() {}
+
+BitSet::BitSet(unsigned int size)
+{
+	resize(size);
+}
+
+void BitSet::resize(unsigned int size)
+{
+	this->bits = size;
+	this->words.resize((size + 63) / 64, 0);
+	// make sure bits beyond the size stay zero, count() and includes() rely on that
+	if (size % 64 != 0)
+		this->words.back() &= (1ULL << (size % 64)) - 1;
+}
+
+void BitSet::clear()
+{
+	for (uint64_t& w : this->words)
+		w = 0;
+}
+
+void BitSet::set(unsigned int bit)
+{
+	if (bit >= this->bits) return;
+	this->words[bit / 64] |= 1ULL << (bit % 64);
+}
+
+void BitSet::reset(unsigned int bit)
+{
+	if (bit >= this->bits) return;
+	this->words[bit / 64] &= ~(1ULL << (bit % 64));
+}
+
+bool BitSet::test(unsigned int bit) const
+{
+	if (bit >= this->bits) return false;
+	return this->words[bit / 64] & (1ULL << (bit % 64));
+}
+
+unsigned int BitSet::next(unsigned int bit) const
+{
+	// returns the index of the first set bit at or after the supplied one, or size() if there is none
+	if (bit >= this->bits) return this->bits;
+	unsigned int w = bit / 64;
+	uint64_t word = this->words[w] & (~0ULL << (bit % 64));
+	while (word == 0)
+	{
+		if (++w >= this->words.size()) return this->bits;
+		word = this->words[w];
+	}
+	return w * 64 + std::countr_zero(word);
+}
+
+unsigned int BitSet::count() const
+{
+	unsigned int n = 0;
+	for (uint64_t w : this->words)
+		n += std::popcount(w);
+	return n;
+}
+
+unsigned int BitSet::countWithout(const BitSet& other) const
+{
+	// number of bits set in this set but not in the other one
+	unsigned int n = 0;
+	for (unsigned int i = 0; i < this->words.size(); i++)
+		n += std::popcount(this->words[i] & ~(i < other.words.size() ? other.words[i] : 0));
+	return n;
+}
+
+unsigned int BitSet::size() const
+{
+	return this->bits;
+}
+
+bool BitSet::any() const
+{
+	for (uint64_t w : this->words)
+		if (w) return true;
+	return false;
+}
+
+bool BitSet::intersects(const BitSet& other) const
+{
+	unsigned int n = std::min(this->words.size(), other.words.size());
+	for (unsigned int i = 0; i < n; i++)
+		if (this->words[i] & other.words[i]) return true;
+	return false;
+}
+
+bool BitSet::includes(const BitSet& other) const
+{
+	// true if every bit set in the other set is also set in this one
+	for (unsigned int i = 0; i < other.words.size(); i++)
+	{
+		uint64_t w = i < this->words.size() ? this->words[i] : 0;
+		if (other.words[i] & ~w) return false;
+	}
+	return true;
+}
+
+void BitSet::subtract(const BitSet& other)
+{
+	unsigned int n = std::min(this->words.size(), other.words.size());
+	for (unsigned int i = 0; i < n; i++)
+		this->words[i] &= ~other.words[i];
+}
+
+BitSet& BitSet::operator|=(const BitSet& other)
+{
+	unsigned int n = std::min(this->words.size(), other.words.size());
+	for (unsigned int i = 0; i < n; i++)
+		this->words[i] |= other.words[i];
+	return *this;
+}
+
+BitSet& BitSet::operator&=(const BitSet& other)
+{
+	for (unsigned int i = 0; i < this->words.size(); i++)
+		this->words[i] &= i < other.words.size() ? other.words[i] : 0;
+	return *this;
+}
+
+bool BitSet::operator==(const BitSet& other) const
+{
+	return this->bits == other.bits && this->words == other.words;
+}
+
+bool BitSet::operator!=(const BitSet& other) const
+{
+	return !(*this == other);
+}
@@ -12,114 +12,74 @@
 #include <stdio.h>
 #include <string>
 #include <vector>
-#include <fstream>
-#include <sstream>
+#include <memory>
+#include <algorithm>
 #include "tableprint.hpp"
 #include "truthtable.hpp"
-#include "kvm.hpp"
 #include "qmcp.hpp"
-
-bool process_table(TruthTable& table, bool verbose)
+#include "frameprint.hpp"
+#include "threadpool.hpp"
+#include "benchmark.hpp"
+#include "solverstats.hpp"
+#include "resultwriter.hpp"
+#include "solver.hpp"
+#include "batch.hpp"
+#include "server.hpp"
+
+bool process_table(TruthTable& table, const SolverOptions& options)
 {
 
-	wprintf(L"[i] starting to process table ...\n");
-	print_truthtable(table);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-	std::vector<std::vector<QMCImplicant>> finalTerms;
+	info_print(L"[i] starting to process table ...\n");
+	if (!options.quiet)
+		print_truthtable(table);
 
-	for (unsigned int o = 0; o < table.outputCount(); o++)
+	std::vector<std::vector<QMCImplicant>> finalTerms;
+	std::vector<bool> complemented;
+	std::vector<OutputStats> stats;
+	NPNCache cache;
+	solve_table(table, options, finalTerms, complemented, options.stats ? &stats : nullptr, nullptr, &cache);
+
+	info_print(L"[i] terms for all outputs completed:\n");
+	if (options.format == ResultFormat::FRAME)
+		print_result_table(finalTerms, complemented);
+	else
+		write_results(finalTerms, complemented, table.inputCount(), options.format);
+
+	if (options.stats)
 	{
-
-		wprintf(L"[i] solve for output %u (%u/%u) ...\n", o, o+1, table.outputCount());
-
-		/**
-		 * here we convert the truth table to an KV-map
-		 * this mainly serves two purposes:
-		 * - fill in the gaps in the truth table (omitted don't care states)
-		 * - give a visual representation of the function currently being processed
-		 *
-		 * this could be done without an KV-map
-		 */
-		wprintf(L"[i] generate KV map to generate fully defined function ...\n");
-		KVMap kvMap(table, o);
-		if (verbose) print_kvmap(kvMap);
-
-		/**
-		 * next the QMC (Quine–McCluskey) algorithm is applied.
-		 * here we initialize the initial minterms in the QMC-stack with the states
-		 * of the KV-map which evaluate either to TRUE or DONT_CARE.
-		 */
-		wprintf(L"[i] initialize QMC implicant chart ...\n");
-		QMCStack implicantStack;
-		implicantStack.initialize(kvMap);
-
-		/**
-		 * next the QMC algorithm is applied to find the prime implicants.
-		 * these can not be combined any further and are highlighted in the printed table.
-		 */
-		wprintf(L"[i] searching for prime implicants ...\n");
-		while (implicantStack.tryMerge());
-		if (verbose) print_qmcstack(implicantStack);
-
-		/**
-		 * here we extract all prime implicants from the stack and put them
-		 * into an QMC prime implicant chart.
-		 */
-		wprintf(L"[i] initializing prime implicant chart ...\n");
-		QMCPrimeChart chart;
-		chart.initialize(implicantStack);
-		if (verbose) print_qmcchart(chart);
-
-		/**
-		 * identifying the essential prime implicant terms in the chart and
-		 * remove them and store them in an list
-		 */
-		wprintf(L"[i] calculating optimal prime implicants for minimal logical function ...\n");
-		wprintf(L"[i] identifying essential prime implicants ... ");
-		std::vector<QMCImplicant> essentialPrimeImplicants;
-		chart.extractEPIs(essentialPrimeImplicants);
-		wprintf(L"EPIs: %u\n", essentialPrimeImplicants.size());
-
-		/**
-		 * if non essential primes are remaining, find the optimal combination of them
-		 * which covers all remaining minterms with the least number of terms.
-		 */
-		if (chart.mintermIds().size() != 0)
-		{
-			wprintf(L"[i] non essential prime implicants remaining, continue ...\n");
-			if (verbose) print_qmcchart(chart);
-			chart.findOptimalPrimes(essentialPrimeImplicants);
-
-		}
-
-		finalTerms.push_back(essentialPrimeImplicants);
-		wprintf(L"[i] -> final term: ");
-		print_bool_term(essentialPrimeImplicants);
-		wprintf(L"\n");
-
+		info_print(L"[i] solver statistics:\n");
+		print_solver_stats(stats, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
 	}
 
-	wprintf(L"[i] terms for all outputs completed:\n");
-	print_result_table(finalTerms);
-
 	return true;
 }
 
 int climain(std::string cmdname, std::vector<std::string> args)
 {
 
-	if (args.size() < 4)
+	if (args.size() < 2)
 	{
-		wprintf(L"%s -tt [truth table txt] <-o [num of ouputs] | -i [num of inputs] | -v (verbose output enable)>\n", cmdname.c_str());
+		wprintf(L"%s -tt [truth table txt or pla] <-o [num of ouputs] | -i [num of inputs] | -v (verbose output enable) | -j [num of threads, 0 = all cores] | -cover [bnb|petrick] | -engine [qmc|espresso|bdd|zdd] | -shared (share terms between outputs) | -stats (print solver statistics as JSON) | -q (quiet, only print the results) | -format [text|json|pla]>\n", cmdname.c_str());
+		wprintf(L"%s -batch [directory | manifest] <-tt [truth table txt or pla] | -out [result directory] | -j [num of threads, 0 = all cores] | -i, -o, -cover, -engine, -shared, -q, -format as above>\n", cmdname.c_str());
+		wprintf(L"%s -server [socket path] <-cache [result cache size in MB] | -j [num of threads, 0 = all cores] | -cover, -engine, -format, -q as above>\n", cmdname.c_str());
+		wprintf(L"%s -bench [table spec | suite] <-runs [num of runs] | -j [num of threads, 0 = all cores] | -cover [bnb|petrick]>\n", cmdname.c_str());
 		return 0;
 	}
 
 	_setmode(_fileno(stdout), _O_U16TEXT);
 
-	std::string tableFilePath;
+	std::vector<std::string> tableFilePaths;
+	std::vector<std::string> batchSources;
+	std::string outputDirectory;
+	std::string socketPath;
+	size_t cacheCapacity = 64;
 	unsigned int inputs = 0;
 	unsigned int outputs = 0;
-	bool verbose = false;
+	SolverOptions options;
+	std::vector<std::string> benchSpecs;
+	unsigned int benchRuns = 3;
 
 	for (unsigned int i = 0; i < args.size(); i++)
 	{
@@ -127,7 +87,19 @@ int climain(std::string cmdname, std::vector<std::string> args)
 		if (i != args.size() - 1) {
 			std::string val = args[i + 1];
 			if (flag == "-tt") {
-				tableFilePath = val;
+				tableFilePaths.push_back(val);
+				i++;
+			} else if (flag == "-batch") {
+				batchSources.push_back(val);
+				i++;
+			} else if (flag == "-out") {
+				outputDirectory = val;
+				i++;
+			} else if (flag == "-server") {
+				socketPath = val;
+				i++;
+			} else if (flag == "-cache") {
+				cacheCapacity = std::stoul(val);
 				i++;
 			} else if (flag == "-i") {
 				inputs = std::stoul(val);
@@ -135,111 +107,131 @@ int climain(std::string cmdname, std::vector<std::string> args)
 			} else if (flag == "-o") {
 				outputs = std::stoul(val);
 				i++;
+			} else if (flag == "-j") {
+				options.jobs = std::stoul(val);
+				i++;
+			} else if (flag == "-bench") {
+				if (val == "suite")
+					benchmark_suite(benchSpecs);
+				else
+					benchSpecs.push_back(val);
+				i++;
+			} else if (flag == "-runs") {
+				benchRuns = std::max(1UL, std::stoul(val));
+				i++;
+			} else if (flag == "-cover") {
+				if (val == "petrick") {
+					options.coverMethod = QMCCoverMethod::PETRICK;
+				} else if (val == "bnb") {
+					options.coverMethod = QMCCoverMethod::BRANCH_AND_BOUND;
+				} else {
+					wprintf(L"[!] unknown cover method: %s\n", val.c_str());
+					return 1;
+				}
+				i++;
+			} else if (flag == "-format") {
+				if (val == "text") {
+					options.format = ResultFormat::TEXT;
+				} else if (val == "json") {
+					options.format = ResultFormat::JSON;
+				} else if (val == "pla") {
+					options.format = ResultFormat::PLA;
+				} else {
+					wprintf(L"[!] unknown result format: %s\n", val.c_str());
+					return 1;
+				}
+				i++;
+			} else if (flag == "-engine") {
+				if (val == "espresso") {
+					options.engine = SolverEngine::ESPRESSO;
+				} else if (val == "qmc") {
+					options.engine = SolverEngine::QMC;
+				} else if (val == "bdd") {
+					options.engine = SolverEngine::BDD;
+				} else if (val == "zdd") {
+					options.engine = SolverEngine::ZDD;
+				} else {
+					wprintf(L"[!] unknown engine: %s\n", val.c_str());
+					return 1;
+				}
+				i++;
 			}
 		}
 		if (flag == "-v") {
-			verbose = true;
+			options.verbose = true;
+		} else if (flag == "-shared") {
+			options.sharedTerms = true;
+		} else if (flag == "-stats") {
+			options.stats = true;
+		} else if (flag == "-q") {
+			options.quiet = true;
 		}
 	}
 
-	if (tableFilePath.empty()) {
-		wprintf(L"[!] truth table file not defined!\n");
-		return 1;
-	}
-
-	if (inputs == 0 && outputs == 0) {
-		wprintf(L"[!] number of inputs and/or outputs not defined!\n");
-		return 1;
+	/**
+	 * in quiet mode only the results are printed, in plain text unless an other format is selected.
+	 * the graphical representations of the verbose mode are skipped as well.
+	 */
+	if (options.quiet)
+	{
+		options.verbose = false;
+		if (options.format == ResultFormat::FRAME)
+			options.format = ResultFormat::TEXT;
+		set_quiet_print(true);
 	}
 
-	wprintf(L"[i] loading truth table from file ...\n");
-
-	// try to load truth table file
-	std::string tableStr;
+	/**
+	 * in benchmark mode the tables are generated, and only the timing of the solver stages is printed as JSON
+	 */
+	if (!benchSpecs.empty())
 	{
-		std::ifstream tableFile;
-		tableFile.open(tableFilePath);
-		std::stringstream tableStream;
-		tableStream << tableFile.rdbuf();
-		tableFile.close();
-		tableStr = tableStream.str();
+		if (options.jobs == 1)
+			return run_benchmarks(benchSpecs, benchRuns, options.coverMethod, nullptr) ? 0 : 1;
+		ThreadPool pool(options.jobs);
+		return run_benchmarks(benchSpecs, benchRuns, options.coverMethod, &pool) ? 0 : 1;
 	}
 
-	wprintf(L"[i] parsing :\n%s\n", tableStr.c_str());
+	/**
+	 * in server mode the tables are received over an socket, until the server is stopped by an client
+	 */
+	if (!socketPath.empty())
+		return run_server(socketPath, options, cacheCapacity * 1024 * 1024) ? 0 : 1;
 
-	// try to parse truth table string
-	std::vector<TriStateBool> values;
-	unsigned int width = 0;
+	/**
+	 * in batch mode multiple tables are solved in parallel, one table per thread
+	 */
+	if (!batchSources.empty() || tableFilePaths.size() > 1 || !outputDirectory.empty())
 	{
-		unsigned int pos = 0;
-		unsigned int lastCol = 0;
-		unsigned int lastRow = 0;
-		unsigned int columns = 0;
-		while (true)
-		{
-
-			if (pos == lastRow)
-			{
-				lastRow = tableStr.find("\n", pos) + 1;
-				if (lastRow == 0) break; // end of table string
-				if (width > 0 && width != columns)
-				{
-					wprintf(L"[!] truth table rows mismatch in number of columns!\n");
-					return 1;
-				}
-				width = columns;
-				columns = 0;
-			}
-
-			lastCol = tableStr.find("\t", pos) + 1;
-			if (lastCol == 0) lastCol = lastRow;
-
-			unsigned int pos2 = std::min(lastCol, lastRow);
-
-			std::string valStr = tableStr.substr(pos,  pos2 - pos);
-			if (valStr.find("TRUE") != std::string::npos || valStr.find("true") != std::string::npos || valStr.find("1") != std::string::npos) {
-				values.push_back(TriStateBool::TRUE);
-			} else if (valStr.find("FALSE") != std::string::npos || valStr.find("false") != std::string::npos || valStr.find("0") != std::string::npos) {
-				values.push_back(TriStateBool::FALSE);
-			} else {
-				values.push_back(TriStateBool::DONT_CARE);
-			}
-
-			pos = pos2;
-			columns++;
-
+		if (options.stats) {
+			wprintf(L"[!] -stats is not supported in batch mode!\n");
+			return 1;
+		}
+		std::vector<BatchTable> batchTables;
+		for (const std::string& path : tableFilePaths)
+			batchTables.push_back({ path, inputs, outputs });
+		for (const std::string& source : batchSources)
+			if (!collect_batch_tables(source, inputs, outputs, batchTables))
+				return 1;
+		if (batchTables.empty()) {
+			wprintf(L"[!] no truth table files found for batch!\n");
+			return 1;
 		}
+		return run_batch(batchTables, options, outputDirectory) ? 0 : 1;
 	}
 
-	// validate data
-	wprintf(L"[i] checking cell count : width = %u data = %lu ... ", width, values.size());
-	if (width == 0) {
-		wprintf(L"\n[!] empty table data!\n");
-		return 1;
-	} else if (values.size() % width != 0) {
-		wprintf(L"\n[!] table data incomplete!\n");
+	if (tableFilePaths.empty()) {
+		wprintf(L"[!] truth table file not defined!\n");
 		return 1;
 	}
-	wprintf(L"OK\n", width);
 
-	wprintf(L"[i] checking input output count : width = %u inputs = %u outputs = %u ... ", width, inputs, outputs);
-	if (inputs == 0)
-		inputs = width - outputs;
-	else if (outputs == 0)
-		outputs = width - inputs;
-	else if (outputs + inputs != width)
-	{
-		wprintf(L"\n[!] number of inputs + outputs does not match table width!\n");
+	std::unique_ptr<TruthTable> table = load_table(tableFilePaths[0], inputs, outputs, options);
+	if (!table)
 		return 1;
-	}
-	wprintf(L"OK\n", width);
-
-	// fill table with output states
-	TruthTable table(values, inputs, outputs);
 
-	wprintf(L"[i] table loaded successfully\n");
+	if (!check_table(*table, options))
+		return 1;
 
-	return process_table(table, verbose) ? 0 : -1;
+	return process_table(*table, options) ? 0 : -1;
 
 }
 
@@ -0,0 +1,214 @@
+/*
+ * coversolver.cpp
+ *
+ * An branch and bound solver for the minimum cost set cover problem.
+ * Used to find the cheapest combination of prime implicants (rows) which covers all minterms (columns) of an prime chart.
+ *
+ * The search always branches on the uncovered column with the fewest remaining candidate rows.
+ * After an row was tried for an column, it is excluded from the following branches, since all covers containing it have been searched already.
+ * Rows which cover only an subset of the remaining columns of another row with at most the same cost are excluded as well.
+ * Branches are cut off using an lower bound from an set of independent columns (columns which share no candidate row),
+ * each of them requires an different row, so the sum of their cheapest candidates can not be undercut.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <algorithm>
+#include <climits>
+#include "coversolver.hpp"
+
+CoverSolver::CoverSolver(const std::vector<BitSet>& rows, const std::vector<unsigned int>& costs, unsigned int columns)
+{
+	this->columns = columns;
+	this->rows = rows;
+	this->costs = costs;
+	this->bestCost = UINT_MAX;
+	this->solved = false;
+	this->nodes = 0;
+
+	// transpose the rows, to get the candidate rows for each column
+	this->columnRows.assign(columns, BitSet(rows.size()));
+	for (unsigned int r = 0; r < rows.size(); r++)
+		for (unsigned int c = rows[r].next(0); c < columns; c = rows[r].next(c + 1))
+			this->columnRows[c].set(r);
+}
+
+bool CoverSolver::solve(std::vector<unsigned int>& selectedRows)
+{
+	BitSet uncovered(this->columns);
+	for (unsigned int c = 0; c < this->columns; c++)
+		uncovered.set(c);
+
+	// every column needs at least one candidate, otherwise there is no cover at all
+	for (unsigned int c = 0; c < this->columns; c++)
+		if (!this->columnRows[c].any())
+			return false;
+
+	// start with an greedy solution, so that the search has an upper bound from the beginning
+	greedyCover(uncovered);
+
+	BitSet excluded(this->rows.size());
+	this->selection.clear();
+	search(uncovered, excluded, 0);
+
+	selectedRows = this->best;
+	std::sort(selectedRows.begin(), selectedRows.end());
+	return this->solved;
+}
+
+uint64_t CoverSolver::nodeCount() const
+{
+	return this->nodes;
+}
+
+void CoverSolver::greedyCover(const BitSet& uncovered)
+{
+	// repeatedly take the row with the lowest cost per newly covered column
+	BitSet remaining = uncovered;
+	std::vector<unsigned int> cover;
+	unsigned int cost = 0;
+	while (remaining.any())
+	{
+		unsigned int bestRow = this->rows.size();
+		double bestRatio = 0;
+		for (unsigned int r = 0; r < this->rows.size(); r++)
+		{
+			BitSet gain = this->rows[r];
+			gain &= remaining;
+			unsigned int n = gain.count();
+			if (n == 0) continue;
+			double ratio = (this->costs[r] + 1.0) / n;
+			if (bestRow == this->rows.size() || ratio < bestRatio)
+			{
+				bestRow = r;
+				bestRatio = ratio;
+			}
+		}
+		if (bestRow == this->rows.size()) return;
+		cover.push_back(bestRow);
+		cost += this->costs[bestRow];
+		remaining.subtract(this->rows[bestRow]);
+	}
+
+	this->best = cover;
+	this->bestCost = cost;
+	this->solved = true;
+}
+
+unsigned int CoverSolver::lowerBound(const BitSet& uncovered, const BitSet& excluded) const
+{
+	// collect columns which do not share any candidate row, each of them needs its own row
+	// columns with few candidates are preferred, they block the fewest other columns
+	std::vector<std::pair<unsigned int, unsigned int>> order;
+	for (unsigned int c = uncovered.next(0); c < this->columns; c = uncovered.next(c + 1))
+		order.push_back({ this->columnRows[c].countWithout(excluded), c });
+	std::sort(order.begin(), order.end());
+
+	BitSet used(this->rows.size());
+	unsigned int bound = 0;
+	for (auto [candidateCount, c] : order)
+	{
+		if (candidateCount == 0) return UINT_MAX; // column can not be covered anymore
+		if (this->columnRows[c].intersects(used)) continue;
+
+		unsigned int cheapest = UINT_MAX;
+		for (unsigned int r = this->columnRows[c].next(0); r < this->rows.size(); r = this->columnRows[c].next(r + 1))
+			if (!excluded.test(r))
+				cheapest = std::min(cheapest, this->costs[r]);
+
+		bound += cheapest;
+		used |= this->columnRows[c];
+		used.subtract(excluded);
+	}
+	return bound;
+}
+
+void CoverSolver::excludeDominatedRows(const BitSet& uncovered, BitSet& excluded, std::vector<unsigned int>& dominated) const
+{
+	// an row is not needed if another row covers at least the same uncovered columns for at most the same cost
+	std::vector<BitSet> remaining(this->rows.size());
+	for (unsigned int r = 0; r < this->rows.size(); r++)
+	{
+		if (excluded.test(r)) continue;
+		remaining[r] = this->rows[r];
+		remaining[r] &= uncovered;
+	}
+	for (unsigned int r1 = 0; r1 < this->rows.size(); r1++)
+	{
+		if (excluded.test(r1)) continue;
+		for (unsigned int r2 = 0; r2 < this->rows.size(); r2++)
+		{
+			if (r1 == r2 || excluded.test(r2) || this->costs[r2] > this->costs[r1]) continue;
+			if (!remaining[r2].includes(remaining[r1])) continue;
+			// for equal rows with equal cost keep the first one
+			if (this->costs[r2] == this->costs[r1] && r2 > r1 && remaining[r1].includes(remaining[r2])) continue;
+			excluded.set(r1);
+			dominated.push_back(r1);
+			break;
+		}
+	}
+}
+
+void CoverSolver::search(const BitSet& uncovered, BitSet& excluded, unsigned int cost)
+{
+	this->nodes++;
+	if (!uncovered.any())
+	{
+		if (cost < this->bestCost)
+		{
+			this->bestCost = cost;
+			this->best = this->selection;
+			this->solved = true;
+		}
+		return;
+	}
+
+	// remove rows which are not needed for the remaining columns, they are restored when leaving this branch
+	std::vector<unsigned int> dominated;
+	excludeDominatedRows(uncovered, excluded, dominated);
+
+	unsigned int bound = lowerBound(uncovered, excluded);
+	if (bound != UINT_MAX && cost + bound < this->bestCost)
+	{
+
+		// find the uncovered column with the fewest candidates left
+		unsigned int column = this->columns;
+		unsigned int fewest = UINT_MAX;
+		for (unsigned int c = uncovered.next(0); c < this->columns; c = uncovered.next(c + 1))
+		{
+			unsigned int n = this->columnRows[c].countWithout(excluded);
+			if (n < fewest)
+			{
+				fewest = n;
+				column = c;
+			}
+		}
+
+		// try the candidates for this column, cheapest first
+		std::vector<unsigned int> candidates;
+		for (unsigned int r = this->columnRows[column].next(0); r < this->rows.size(); r = this->columnRows[column].next(r + 1))
+			if (!excluded.test(r))
+				candidates.push_back(r);
+		std::stable_sort(candidates.begin(), candidates.end(), [this](unsigned int a, unsigned int b) {
+			return this->costs[a] < this->costs[b];
+		});
+
+		for (unsigned int r : candidates)
+		{
+			BitSet remaining = uncovered;
+			remaining.subtract(this->rows[r]);
+			this->selection.push_back(r);
+			search(remaining, excluded, cost + this->costs[r]);
+			this->selection.pop_back();
+			excluded.set(r);
+		}
+
+		for (unsigned int r : candidates)
+			excluded.reset(r);
+
+	}
+
+	for (unsigned int r : dominated)
+		excluded.reset(r);
+}
@@ -0,0 +1,436 @@
+/*
+ * espresso.cpp
+ *
+ * Implementation of an heuristic two level minimization in the style of the "Espresso" algorithm.
+ * Unlike the QMC algorithm, this never enumerates the minterms of the function, it works directly on the
+ * cubes of the truth table rows, which makes it usable for functions with a large number of inputs.
+ *
+ * The cover is improved by repeating the following steps until its cost does not decrease anymore:
+ * - EXPAND: make each cube as large as possible without intersecting the OFF-set, remove cubes covered by it
+ * - IRREDUNDANT: remove cubes whose ON-set minterms are all covered by other cubes
+ * - REDUCE: shrink each cube to the smallest cube containing the ON-set minterms only it covers
+ * The result is close to minimal, but unlike the QMC algorithm not guaranteed to be optimal.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <algorithm>
+#include <bit>
+#include <unordered_set>
+#include "espresso.hpp"
+
+/** Cube Operations **/
+
+bool cubesIntersect(const QMCCube& a, const QMCCube& b)
+{
+	// the cubes intersect if no input relevant for both has different values
+	return ((a.value ^ b.value) & a.mask & b.mask) == 0;
+}
+
+bool cubeContains(const QMCCube& a, const QMCCube& b)
+{
+	// a contains b if every input relevant for a is relevant for b with the same value
+	return (a.mask & ~b.mask) == 0 && ((a.value ^ b.value) & a.mask) == 0;
+}
+
+QMCCube cubeIntersection(const QMCCube& a, const QMCCube& b)
+{
+	return { a.value | b.value, a.mask | b.mask };
+}
+
+QMCCube supercube(const QMCCube& a, const QMCCube& b)
+{
+	uint64_t mask = a.mask & b.mask & ~(a.value ^ b.value);
+	return { a.value & mask, mask };
+}
+
+void cubeSharp(const QMCCube& a, const QMCCube& b, cube_cover_t& result)
+{
+	// append the part of a which is not contained in b as disjoint cubes
+	if (!cubesIntersect(a, b))
+	{
+		result.push_back(a);
+		return;
+	}
+	uint64_t split = b.mask & ~a.mask;
+	QMCCube rest = a;
+	while (split != 0)
+	{
+		uint64_t bit = split & -split;
+		split &= split - 1;
+		result.push_back({ rest.value | (~b.value & bit), rest.mask | bit });
+		rest.value |= b.value & bit;
+		rest.mask |= bit;
+	}
+}
+
+void coverSharp(cube_cover_t& cover, const QMCCube& b)
+{
+	cube_cover_t result;
+	for (const QMCCube& a : cover)
+		cubeSharp(a, b, result);
+	cover.swap(result);
+}
+
+void coverSimplify(cube_cover_t& cover)
+{
+	// merge cubes which only differ in the value of one input and remove cubes contained in an other one, this keeps the covered states
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (size_t i = 0; i < cover.size(); i++)
+			for (size_t j = i + 1; j < cover.size(); j++)
+			{
+				uint64_t difference = (cover[i].value ^ cover[j].value) & cover[i].mask;
+				if (cover[i].mask == cover[j].mask && std::popcount(difference) == 1)
+					cover[i] = { cover[i].value & ~difference, cover[i].mask & ~difference };
+				else if (cubeContains(cover[j], cover[i]))
+					cover[i] = cover[j];
+				else if (!cubeContains(cover[i], cover[j]))
+					continue;
+				// the cube j is now part of cube i, which has to be compared with all other cubes again
+				cover[j] = cover.back();
+				cover.pop_back();
+				j = i;
+				changed = true;
+			}
+	}
+}
+
+cube_cover_t cofactor(const cube_cover_t& cover, const QMCCube& p)
+{
+	cube_cover_t result;
+	for (const QMCCube& c : cover)
+		if (cubesIntersect(c, p))
+			result.push_back({ c.value & ~p.mask, c.mask & ~p.mask });
+	return result;
+}
+
+uint64_t splitInput(const cube_cover_t& cover, uint64_t inputs)
+{
+	// the input of the given ones which is relevant for the most cubes
+	uint64_t splitBit = 0;
+	unsigned int splitCount = 0;
+	for (; inputs != 0; inputs &= inputs - 1)
+	{
+		uint64_t bit = inputs & -inputs;
+		unsigned int count = 0;
+		for (const QMCCube& c : cover)
+			if (c.mask & bit) count++;
+		if (count > splitCount)
+		{
+			splitCount = count;
+			splitBit = bit;
+		}
+	}
+	return splitBit;
+}
+
+bool tautology(const cube_cover_t& cover)
+{
+	if (cover.empty()) return false;
+
+	uint64_t positive = 0;
+	uint64_t negative = 0;
+	for (const QMCCube& c : cover)
+	{
+		if (c.mask == 0) return true; // contains the universal cube
+		positive |= c.mask & c.value;
+		negative |= c.mask & ~c.value;
+	}
+
+	// an cover which is unate in all inputs is only an tautology if it contains the universal cube
+	uint64_t binate = positive & negative;
+	if (binate == 0) return false;
+
+	uint64_t splitBit = splitInput(cover, binate);
+	return tautology(cofactor(cover, { 0, splitBit })) && tautology(cofactor(cover, { splitBit, splitBit }));
+}
+
+cube_cover_t coverComplement(const cube_cover_t& cover)
+{
+	if (cover.empty()) return { QMCCube() };
+
+	uint64_t positive = 0;
+	uint64_t negative = 0;
+	for (const QMCCube& c : cover)
+	{
+		if (c.mask == 0) return {}; // contains the universal cube
+		positive |= c.mask & c.value;
+		negative |= c.mask & ~c.value;
+	}
+
+	// the complement of an single cube are the cubes with one of its inputs inverted
+	cube_cover_t result;
+	if (cover.size() == 1)
+	{
+		cubeSharp(QMCCube(), cover[0], result);
+		return result;
+	}
+
+	// split on an binate input if there is one, the complement is the complement of both cofactors
+	uint64_t binate = positive & negative;
+	uint64_t splitBit = splitInput(cover, binate != 0 ? binate : positive | negative);
+	cube_cover_t negativeHalf = coverComplement(cofactor(cover, { 0, splitBit }));
+	cube_cover_t positiveHalf = coverComplement(cofactor(cover, { splitBit, splitBit }));
+
+	// the same cube in both halves is merged back into one cube without the input
+	std::unordered_set<QMCCube, QMCCubeHash> positiveCubes(positiveHalf.begin(), positiveHalf.end());
+	for (const QMCCube& c : negativeHalf)
+	{
+		if (positiveCubes.erase(c) > 0)
+			result.push_back(c);
+		else
+			result.push_back({ c.value, c.mask | splitBit });
+	}
+	for (const QMCCube& c : positiveHalf)
+		if (positiveCubes.count(c) > 0)
+			result.push_back({ c.value | splitBit, c.mask | splitBit });
+	return result;
+}
+
+bool coverContains(const cube_cover_t& cover, const QMCCube& cube)
+{
+	for (const QMCCube& c : cover)
+		if (cubeContains(c, cube)) return true;
+	return tautology(cofactor(cover, cube));
+}
+
+/** Espresso Cover **/
+
+void EspressoCover::initialize(const TruthTable& table, unsigned int output)
+{
+	this->variables = table.inputCount();
+	this->onSet.clear();
+	this->offSet.clear();
+	this->cover.clear();
+
+	std::vector<QMCCube> rowCubes;
+	std::vector<TriStateBool> rowValues;
+	for (unsigned int s = 0; s < table.stateCount(); s++)
+	{
+		// rows which do not define this output are skipped completely, they do not hide the following rows
+		TriStateBool value = table.output(s, output);
+		if (value == TriStateBool::UNDEFINED) continue;
+
+		QMCCube cube;
+		for (unsigned int i = 0; i < this->variables; i++)
+		{
+			TriStateBool in = table.input(s, i);
+			if (in == TriStateBool::DONT_CARE) continue;
+			cube.mask |= 1ULL << i;
+			if (in == TriStateBool::TRUE) cube.value |= 1ULL << i;
+		}
+		rowCubes.push_back(cube);
+		rowValues.push_back(value);
+
+		// DONT_CARE rows are in neither set, they only hide the parts of the following rows they overlap
+		if (value == TriStateBool::DONT_CARE) continue;
+
+		// like TruthTable::find(), the first row matching an state defines its value, so remove the parts of earlier rows
+		cube_cover_t pieces;
+		if (cube.mask == (this->variables >= 64 ? ~0ULL : (1ULL << this->variables) - 1) && !table.hasUndefinedOutputs())
+		{
+			if (table.find(cube.value) != s) continue;
+			pieces.push_back(cube);
+		}
+		else
+		{
+			// only earlier rows with an other value change the overlapping states, an overlap with the same value does not
+			pieces.push_back(cube);
+			for (unsigned int e = 0; e < rowCubes.size() - 1 && !pieces.empty(); e++)
+			{
+				if (rowValues[e] == value || !cubesIntersect(cube, rowCubes[e])) continue;
+				coverSharp(pieces, rowCubes[e]);
+				coverSimplify(pieces);
+			}
+		}
+
+		if (value == TriStateBool::TRUE)
+			this->onSet.insert(this->onSet.end(), pieces.begin(), pieces.end());
+		else if (value == TriStateBool::FALSE)
+			this->offSet.insert(this->offSet.end(), pieces.begin(), pieces.end());
+	}
+
+	// states not defined by any row are DONT_CARE, so they are in neither set, unless the table defines them as FALSE
+	if (table.undefinedStateValue() == TriStateBool::FALSE)
+	{
+		cube_cover_t undefined = coverComplement(rowCubes);
+		this->offSet.insert(this->offSet.end(), undefined.begin(), undefined.end());
+	}
+}
+
+void EspressoCover::minimize()
+{
+	this->cover = this->onSet;
+	expand();
+	irredundant();
+
+	cube_cover_t bestCover = this->cover;
+	unsigned int bestCost = cost();
+	while (true)
+	{
+		reduce();
+		expand();
+		irredundant();
+
+		if (cost() >= bestCost) break;
+		bestCover = this->cover;
+		bestCost = cost();
+	}
+	this->cover = bestCover;
+}
+
+void EspressoCover::expand()
+{
+	// expand the largest cubes first, they are the most likely to cover other cubes
+	std::stable_sort(this->cover.begin(), this->cover.end(), [](const QMCCube& a, const QMCCube& b) {
+		return std::popcount(a.mask) < std::popcount(b.mask);
+	});
+
+	cube_cover_t expanded;
+	std::vector<bool> covered(this->cover.size(), false);
+	for (unsigned int i = 0; i < this->cover.size(); i++)
+	{
+		if (covered[i]) continue;
+		QMCCube cube = this->cover[i];
+
+		// count for each input how many OFF-set cubes prevent removing it, try the least blocked inputs first
+		std::vector<std::pair<unsigned int, uint64_t>> order;
+		for (uint64_t inputs = cube.mask; inputs != 0; inputs &= inputs - 1)
+		{
+			uint64_t bit = inputs & -inputs;
+			unsigned int blocking = 0;
+			for (const QMCCube& off : this->offSet)
+				if (((cube.value ^ off.value) & cube.mask & off.mask) == bit)
+					blocking++;
+			order.push_back({ blocking, bit });
+		}
+		std::stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+			return a.first < b.first;
+		});
+
+		for (auto [blocking, bit] : order)
+		{
+			QMCCube raised = { cube.value & ~bit, cube.mask & ~bit };
+			bool valid = true;
+			for (const QMCCube& off : this->offSet)
+				if (cubesIntersect(raised, off))
+				{
+					valid = false;
+					break;
+				}
+			if (valid) cube = raised;
+		}
+
+		for (unsigned int j = i + 1; j < this->cover.size(); j++)
+			if (!covered[j] && cubeContains(cube, this->cover[j]))
+				covered[j] = true;
+		expanded.push_back(cube);
+	}
+
+	this->cover = expanded;
+}
+
+void EspressoCover::irredundant()
+{
+	// try to remove the most expensive cubes first
+	std::stable_sort(this->cover.begin(), this->cover.end(), [](const QMCCube& a, const QMCCube& b) {
+		return std::popcount(a.mask) > std::popcount(b.mask);
+	});
+
+	std::vector<bool> removed(this->cover.size(), false);
+	for (unsigned int i = 0; i < this->cover.size(); i++)
+	{
+		cube_cover_t others;
+		for (unsigned int j = 0; j < this->cover.size(); j++)
+			if (j != i && !removed[j])
+				others.push_back(this->cover[j]);
+
+		// the cube is redundant if all ON-set minterms within it are covered by the other cubes
+		bool redundant = true;
+		for (const QMCCube& on : this->onSet)
+			if (cubesIntersect(on, this->cover[i]) && !coverContains(others, cubeIntersection(on, this->cover[i])))
+			{
+				redundant = false;
+				break;
+			}
+		removed[i] = redundant;
+	}
+
+	cube_cover_t irredundant;
+	for (unsigned int i = 0; i < this->cover.size(); i++)
+		if (!removed[i])
+			irredundant.push_back(this->cover[i]);
+	this->cover = irredundant;
+}
+
+void EspressoCover::reduce()
+{
+	// reduce the largest cubes first, they have the most room to move
+	std::stable_sort(this->cover.begin(), this->cover.end(), [](const QMCCube& a, const QMCCube& b) {
+		return std::popcount(a.mask) < std::popcount(b.mask);
+	});
+
+	std::vector<bool> removed(this->cover.size(), false);
+	for (unsigned int i = 0; i < this->cover.size(); i++)
+	{
+		// collect the ON-set minterms which are only covered by this cube
+		cube_cover_t pieces;
+		for (const QMCCube& on : this->onSet)
+			if (cubesIntersect(on, this->cover[i]))
+				pieces.push_back(cubeIntersection(on, this->cover[i]));
+		for (unsigned int j = 0; j < this->cover.size() && !pieces.empty(); j++)
+			if (j != i && !removed[j] && cubesIntersect(this->cover[i], this->cover[j]))
+				coverSharp(pieces, this->cover[j]);
+
+		if (pieces.empty())
+		{
+			removed[i] = true;
+			continue;
+		}
+
+		// replace the cube with the smallest cube containing all of them
+		QMCCube reduced = pieces.front();
+		for (const QMCCube& piece : pieces)
+			reduced = supercube(reduced, piece);
+		this->cover[i] = reduced;
+	}
+
+	cube_cover_t reducedCover;
+	for (unsigned int i = 0; i < this->cover.size(); i++)
+		if (!removed[i])
+			reducedCover.push_back(this->cover[i]);
+	this->cover = reducedCover;
+}
+
+void EspressoCover::implicants(std::vector<QMCImplicant>& implicants) const
+{
+	for (const QMCCube& cube : this->cover)
+	{
+		QMCImplicant implicant;
+		implicant.initialize(cube, this->variables);
+		implicants.push_back(implicant);
+	}
+}
+
+const cube_cover_t& EspressoCover::cubes() const
+{
+	return this->cover;
+}
+
+unsigned int EspressoCover::cost() const
+{
+	// the number of cubes is minimized first, then the number of literals
+	unsigned int literals = 0;
+	for (const QMCCube& cube : this->cover)
+		literals += std::popcount(cube.mask);
+	return this->cover.size() * (this->variables + 1) + literals;
+}
+
+unsigned int EspressoCover::variableCount() const
+{
+	return this->variables;
+}
@@ -8,8 +8,11 @@
  */
 
 #include <stdio.h>
+#include <stdarg.h>
 #include "frameprint.hpp"
 
+static bool quietPrint = false;
+
 void print_n(unsigned int n, const wchar_t* s) {
 	for (unsigned int i = 0; i < n; i++)
 		wprintf(s);
@@ -64,3 +67,22 @@ void print_frame_bottom(unsigned int width) {
 	wprintf(L"╝\n");
 }
 
+std::unique_lock<std::recursive_mutex> print_lock() {
+	// used to keep the output of multiple threads from interleaving, hold it while printing an line or an frame
+	static std::recursive_mutex printMutex;
+	return std::unique_lock<std::recursive_mutex>(printMutex);
+}
+
+void set_quiet_print(bool quiet) {
+	quietPrint = quiet;
+}
+
+void info_print(const wchar_t* format, ...) {
+	// progress messages, these are skipped in quiet mode
+	if (quietPrint) return;
+	auto lock = print_lock();
+	va_list args;
+	va_start(args, format);
+	vwprintf(format, args);
+	va_end(args);
+}
@@ -56,16 +56,20 @@ KVMap::KVMap(const TruthTable& table, unsigned int output)
 
 	this->data.clear();
 	this->data.resize(ncell);
-	TriStateBool vars[this->variables];
+
+	// the sets are indexed by the state of all inputs, with the first input as the most significant bit
+	BitSet onSet, dcSet;
+	table.outputSets(output, onSet, dcSet);
 
 	for (unsigned int column = 0; column < this->width; column++)
 		for (unsigned int row = 0; row < this->height; row++)
 		{
+			unsigned int state = 0;
 			for (unsigned int var = 0; var < this->variables; var++) {
-				vars[var] = kvm_cell_var(var, column, row) ? TriStateBool::TRUE : TriStateBool::FALSE;
+				if (kvm_cell_var(var, column, row))
+					state |= 1U << (this->variables - 1 - var);
 			}
-			unsigned int stateIndx = table.find(vars);
-			this->data[row * this->width + column] = stateIndx == table.stateCount() ? TriStateBool::DONT_CARE : table.output(stateIndx, output);
+			this->data[row * this->width + column] = onSet.test(state) ? TriStateBool::TRUE : dcSet.test(state) ? TriStateBool::DONT_CARE : TriStateBool::FALSE;
 		}
 
 }
@@ -0,0 +1,103 @@
+/*
+ * mappedfile.cpp
+ *
+ * Maps an file into memory, so that it can be parsed directly without copying it into an buffer first.
+ * Empty files can not be mapped, they result in an empty view.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include "mappedfile.hpp"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string& path)
+{
+	close();
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) return false;
+	this->fileHandle = file;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size))
+	{
+		close();
+		return false;
+	}
+	this->length = static_cast<size_t>(size.QuadPart);
+	if (this->length == 0) return true;
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+	{
+		close();
+		return false;
+	}
+	this->mappingHandle = mapping;
+	this->data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+	this->fileDescriptor = ::open(path.c_str(), O_RDONLY);
+	if (this->fileDescriptor < 0) return false;
+
+	struct stat status;
+	if (fstat(this->fileDescriptor, &status) != 0)
+	{
+		close();
+		return false;
+	}
+	this->length = static_cast<size_t>(status.st_size);
+	if (this->length == 0) return true;
+
+	void* mapped = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, this->fileDescriptor, 0);
+	if (mapped != MAP_FAILED)
+	{
+		// the file is read once from start to end
+		madvise(mapped, this->length, MADV_SEQUENTIAL);
+		this->data = static_cast<const char*>(mapped);
+	}
+#endif
+	if (this->data == nullptr)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (this->data != nullptr) UnmapViewOfFile(this->data);
+	if (this->mappingHandle != nullptr) CloseHandle(this->mappingHandle);
+	if (this->fileHandle != nullptr) CloseHandle(this->fileHandle);
+	this->mappingHandle = nullptr;
+	this->fileHandle = nullptr;
+#else
+	if (this->data != nullptr) munmap(const_cast<char*>(this->data), this->length);
+	if (this->fileDescriptor >= 0) ::close(this->fileDescriptor);
+	this->fileDescriptor = -1;
+#endif
+	this->data = nullptr;
+	this->length = 0;
+}
+
+std::string_view MappedFile::view() const
+{
+	if (this->data == nullptr) return std::string_view();
+	return std::string_view(this->data, this->length);
+}
@@ -0,0 +1,160 @@
+/*
+ * mergekernel.cpp
+ *
+ * The innermost loop of the QMC algorithm, testing one implicant against an block of implicants of the neighbor group.
+ * Two implicants can be merged if their masks are equal, their values differ in exactly one bit and they share an output.
+ *
+ * The test is done for several implicants at once with AVX2 (4) or AVX-512 (8) instructions, if the CPU supports them.
+ * The kernel is selected once at runtime, so the same executable still runs on CPUs without these extensions.
+ * All kernels return the same bit mask of partners, bit i set for implicant begin + i.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <algorithm>
+#include "mergekernel.hpp"
+
+/**
+ * GCC for windows (mingw) does not realign the stack for AVX (GCC bug 54412), vectors spilled to the stack
+ * would be accessed with aligned moves at misaligned addresses. The build script lets the assembler use unaligned moves
+ * instead and defines QMC_MERGE_KERNEL_UNALIGNED_MOVES, without it only the scalar kernel is compiled for windows.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && (!defined(_WIN32) || defined(QMC_MERGE_KERNEL_UNALIGNED_MOVES))
+#define QMC_MERGE_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+QMCImplicantColumns::QMCImplicantColumns(std::pmr::memory_resource* arena) : masks(arena), values(arena), outputs(arena) {}
+
+void QMCImplicantColumns::push(uint64_t mask, uint64_t value, uint64_t outputs)
+{
+	this->masks.push_back(mask);
+	this->values.push_back(value);
+	this->outputs.push_back(outputs);
+}
+
+void QMCImplicantColumns::reserve(unsigned int implicants)
+{
+	this->masks.reserve(implicants);
+	this->values.reserve(implicants);
+	this->outputs.reserve(implicants);
+}
+
+unsigned int QMCImplicantColumns::size() const
+{
+	return this->masks.size();
+}
+
+typedef uint64_t (*merge_kernel_t)(uint64_t mask, uint64_t value, uint64_t outputs, const uint64_t* masks, const uint64_t* values, const uint64_t* outputMasks, unsigned int count);
+
+static uint64_t merge_partners_scalar(uint64_t mask, uint64_t value, uint64_t outputs, const uint64_t* masks, const uint64_t* values, const uint64_t* outputMasks, unsigned int count)
+{
+	// the difference has exactly one bit set if it is not zero and clearing its lowest bit makes it zero
+	uint64_t partners = 0;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		uint64_t difference = values[i] ^ value;
+		bool mergeable = masks[i] == mask && difference != 0 && (difference & (difference - 1)) == 0 && (outputMasks[i] & outputs) != 0;
+		partners |= static_cast<uint64_t>(mergeable) << i;
+	}
+	return partners;
+}
+
+#ifdef QMC_MERGE_KERNEL_X86
+
+__attribute__((target("avx2")))
+static uint64_t merge_partners_avx2(uint64_t mask, uint64_t value, uint64_t outputs, const uint64_t* masks, const uint64_t* values, const uint64_t* outputMasks, unsigned int count)
+{
+	const __m256i maskVector = _mm256_set1_epi64x(mask);
+	const __m256i valueVector = _mm256_set1_epi64x(value);
+	const __m256i outputVector = _mm256_set1_epi64x(outputs);
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i one = _mm256_set1_epi64x(1);
+
+	uint64_t partners = 0;
+	unsigned int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256i difference = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)), valueVector);
+		__m256i sameMask = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks + i)), maskVector);
+		__m256i noOutput = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(outputMasks + i)), outputVector), zero);
+		__m256i equal = _mm256_cmpeq_epi64(difference, zero);
+		__m256i singleBit = _mm256_cmpeq_epi64(_mm256_and_si256(difference, _mm256_sub_epi64(difference, one)), zero);
+		// lanes with the same mask and an single bit difference, which are neither equal nor without common output
+		__m256i mergeable = _mm256_andnot_si256(_mm256_or_si256(equal, noOutput), _mm256_and_si256(sameMask, singleBit));
+		partners |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(mergeable))) << i;
+	}
+	if (i < count)
+		partners |= merge_partners_scalar(mask, value, outputs, masks + i, values + i, outputMasks + i, count - i) << i;
+	return partners;
+}
+
+__attribute__((target("avx512f")))
+static uint64_t merge_partners_avx512(uint64_t mask, uint64_t value, uint64_t outputs, const uint64_t* masks, const uint64_t* values, const uint64_t* outputMasks, unsigned int count)
+{
+	const __m512i maskVector = _mm512_set1_epi64(mask);
+	const __m512i valueVector = _mm512_set1_epi64(value);
+	const __m512i outputVector = _mm512_set1_epi64(outputs);
+	const __m512i zero = _mm512_setzero_si512();
+	const __m512i one = _mm512_set1_epi64(1);
+
+	// the last block is loaded with an lane mask, so that no implicant behind the end is read
+	uint64_t partners = 0;
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		__mmask8 lanes = count - i >= 8 ? 0xFF : static_cast<__mmask8>((1U << (count - i)) - 1);
+		__m512i difference = _mm512_xor_si512(_mm512_maskz_loadu_epi64(lanes, values + i), valueVector);
+		__mmask8 sameMask = _mm512_mask_cmpeq_epi64_mask(lanes, _mm512_maskz_loadu_epi64(lanes, masks + i), maskVector);
+		__mmask8 commonOutput = _mm512_test_epi64_mask(_mm512_maskz_loadu_epi64(lanes, outputMasks + i), outputVector);
+		__mmask8 notEqual = _mm512_cmpneq_epi64_mask(difference, zero);
+		__mmask8 singleBit = _mm512_cmpeq_epi64_mask(_mm512_and_si512(difference, _mm512_sub_epi64(difference, one)), zero);
+		partners |= static_cast<uint64_t>(sameMask & commonOutput & notEqual & singleBit) << i;
+	}
+	return partners;
+}
+
+#endif
+
+static QMCMergeKernel select_merge_kernel()
+{
+#ifdef QMC_MERGE_KERNEL_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return QMCMergeKernel::KERNEL_AVX512;
+	if (__builtin_cpu_supports("avx2")) return QMCMergeKernel::KERNEL_AVX2;
+#endif
+	return QMCMergeKernel::KERNEL_SCALAR;
+}
+
+QMCMergeKernel merge_kernel()
+{
+	// the CPU is only checked once, the initialization of an static local is thread safe
+	static const QMCMergeKernel kernel = select_merge_kernel();
+	return kernel;
+}
+
+const char* merge_kernel_name()
+{
+	static const char* names[] = { "scalar", "avx2", "avx512" };
+	return names[merge_kernel()];
+}
+
+static merge_kernel_t merge_kernel_function()
+{
+#ifdef QMC_MERGE_KERNEL_X86
+	switch (merge_kernel())
+	{
+	case KERNEL_AVX512: return merge_partners_avx512;
+	case KERNEL_AVX2: return merge_partners_avx2;
+	default: break;
+	}
+#endif
+	return merge_partners_scalar;
+}
+
+uint64_t merge_partners(uint64_t mask, uint64_t value, uint64_t outputs, const QMCImplicantColumns& columns, unsigned int begin, unsigned int count)
+{
+	static const merge_kernel_t kernel = merge_kernel_function();
+	count = std::min(count, std::min<unsigned int>(QMC_MERGE_BLOCK_SIZE, columns.size() - begin));
+	return kernel(mask, value, outputs, columns.masks.data() + begin, columns.values.data() + begin, columns.outputs.data() + begin, count);
+}
@@ -0,0 +1,197 @@
+/*
+ * npncache.cpp
+ *
+ * An cache of minimized functions, shared by all outputs (and tables) which are the same function
+ * up to an permutation and negation of the inputs and an negation of the output (NPN equivalent).
+ *
+ * The key of an function is its canonical form, the smallest ON and DONT_CARE set of all NPN transformations of it.
+ * All transformations are enumerated, the permutations with adjacent swaps (plain changes) and for each of them
+ * the input negations in gray code order, so that each step is only one operation on the 64 bit sets.
+ * For an function with 6 inputs these are 720 * 64 steps.
+ *
+ * The cost of an term (number of terms and relevant inputs) does not change when permuting or negating inputs,
+ * so an minimal term of the canonical form transformed back is an minimal term of the function.
+ * This does not hold for the negation of the output, so the cached terms are kept separate for both output polarities.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <array>
+#include <bit>
+#include "npncache.hpp"
+
+// the states of the sets in which the bit p of the state index is set
+static const uint64_t STATE_BIT_MASKS[6] = {
+	0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+	0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL
+};
+
+size_t NPNKeyHash::operator()(const NPNKey& key) const
+{
+	return std::hash<uint64_t>()(key.onSet * 0x9E3779B97F4A7C15ULL ^ key.dcSet) ^ (key.inputs << 1 | key.outputNegated);
+}
+
+uint64_t negateStateBit(uint64_t set, unsigned int p)
+{
+	unsigned int shift = 1U << p;
+	return ((set & STATE_BIT_MASKS[p]) >> shift) | ((set << shift) & STATE_BIT_MASKS[p]);
+}
+
+uint64_t swapStateBits(uint64_t set, unsigned int p)
+{
+	// swaps the state bits p and p + 1, states in which both are equal stay in place
+	unsigned int shift = 1U << p;
+	uint64_t up = STATE_BIT_MASKS[p] & ~STATE_BIT_MASKS[p + 1];
+	uint64_t down = ~STATE_BIT_MASKS[p] & STATE_BIT_MASKS[p + 1];
+	return (set & ~(up | down)) | ((set & up) << shift) | ((set & down) >> shift);
+}
+
+const std::vector<unsigned int>& plainChanges(unsigned int n)
+{
+	/**
+	 * the adjacent swaps which enumerate all permutations of n elements (Steinhaus-Johnson-Trotter).
+	 * the largest element which can move in its direction is moved, and the larger elements change their direction.
+	 */
+	static const std::array<std::vector<unsigned int>, NPN_CACHE_MAX_INPUTS + 1> changes = []() {
+		std::array<std::vector<unsigned int>, NPN_CACHE_MAX_INPUTS + 1> changes;
+		for (unsigned int n = 1; n <= NPN_CACHE_MAX_INPUTS; n++)
+		{
+			std::vector<int> permutation(n);
+			std::vector<int> direction(n, -1);
+			for (unsigned int i = 0; i < n; i++) permutation[i] = i;
+			while (true)
+			{
+				int mobile = -1;
+				for (int i = 0; i < (int) n; i++)
+				{
+					int j = i + direction[permutation[i]];
+					if (j < 0 || j >= (int) n || permutation[j] > permutation[i]) continue;
+					if (mobile < 0 || permutation[i] > permutation[mobile]) mobile = i;
+				}
+				if (mobile < 0) break;
+				int element = permutation[mobile];
+				int j = mobile + direction[element];
+				std::swap(permutation[mobile], permutation[j]);
+				changes[n].push_back(std::min(mobile, j));
+				for (unsigned int e = element + 1; e < n; e++)
+					direction[e] = -direction[e];
+			}
+		}
+		return changes;
+	}();
+	return changes[n];
+}
+
+bool NPNCache::supports(unsigned int inputs)
+{
+	return inputs >= 1 && inputs <= NPN_CACHE_MAX_INPUTS;
+}
+
+NPNKey NPNCache::canonicalize(unsigned int inputs, uint64_t onSet, uint64_t dcSet, NPNTransform& transform)
+{
+
+	/**
+	 * the transformation is tracked on the bits of the state index, bit b of the original states is bit statePosition[b] of the transformed states.
+	 * the inputs map to the bits of the state index in reverse order, the first input is the most significant bit.
+	 */
+	uint64_t states = inputs == 6 ? ~0ULL : (1ULL << (1U << inputs)) - 1;
+	unsigned int statePosition[NPN_CACHE_MAX_INPUTS];
+	unsigned int stateOrigin[NPN_CACHE_MAX_INPUTS];
+	for (unsigned int b = 0; b < inputs; b++)
+		statePosition[b] = stateOrigin[b] = b;
+	uint64_t stateNegated = 0;
+
+	NPNKey best = { inputs, onSet, dcSet, false };
+	unsigned int bestPosition[NPN_CACHE_MAX_INPUTS];
+	std::copy(statePosition, statePosition + inputs, bestPosition);
+	uint64_t bestNegated = 0;
+
+	const std::vector<unsigned int>& swaps = plainChanges(inputs);
+	for (unsigned int permutation = 0; permutation <= swaps.size(); permutation++)
+	{
+		for (unsigned int gray = 1; gray <= (1U << inputs); gray++)
+		{
+			uint64_t offSet = states & ~(onSet | dcSet);
+			for (bool outputNegated : { false, true })
+			{
+				uint64_t on = outputNegated ? offSet : onSet;
+				if (on > best.onSet || (on == best.onSet && dcSet >= best.dcSet)) continue;
+				best = { inputs, on, dcSet, outputNegated };
+				std::copy(statePosition, statePosition + inputs, bestPosition);
+				bestNegated = stateNegated;
+			}
+
+			// the last step negates the most significant bit again, which restores the original polarity
+			unsigned int p = gray == (1U << inputs) ? inputs - 1 : std::countr_zero(gray);
+			onSet = negateStateBit(onSet, p);
+			dcSet = negateStateBit(dcSet, p);
+			stateNegated ^= 1ULL << stateOrigin[p];
+		}
+
+		if (permutation == swaps.size()) break;
+		unsigned int p = swaps[permutation];
+		onSet = swapStateBits(onSet, p);
+		dcSet = swapStateBits(dcSet, p);
+		std::swap(stateOrigin[p], stateOrigin[p + 1]);
+		statePosition[stateOrigin[p]] = p;
+		statePosition[stateOrigin[p + 1]] = p + 1;
+	}
+
+	// convert the state bits back to inputs
+	transform.inputs = inputs;
+	transform.negated = 0;
+	transform.outputNegated = best.outputNegated;
+	for (unsigned int b = 0; b < inputs; b++)
+	{
+		unsigned int input = inputs - 1 - b;
+		transform.position[input] = inputs - 1 - bestPosition[b];
+		if (bestNegated & (1ULL << b)) transform.negated |= 1ULL << input;
+	}
+	return best;
+
+}
+
+QMCCube NPNCache::transformCube(const QMCCube& cube, const NPNTransform& transform, bool toCanonical)
+{
+	QMCCube result;
+	for (unsigned int i = 0; i < transform.inputs; i++)
+	{
+		unsigned int from = toCanonical ? i : transform.position[i];
+		unsigned int to = toCanonical ? transform.position[i] : i;
+		if (!(cube.mask & (1ULL << from))) continue;
+		result.mask |= 1ULL << to;
+		bool value = (cube.value >> from) & 1;
+		if (value != bool(transform.negated & (1ULL << i)))
+			result.value |= 1ULL << to;
+	}
+	return result;
+}
+
+bool NPNCache::find(const NPNKey& key, const NPNTransform& transform, std::vector<QMCImplicant>& finalTerm)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	auto entry = this->terms.find(key);
+	if (entry == this->terms.end()) return false;
+	finalTerm.clear();
+	for (const QMCCube& cube : entry->second)
+		finalTerm.emplace_back().initialize(transformCube(cube, transform, false), transform.inputs);
+	return true;
+}
+
+void NPNCache::insert(const NPNKey& key, const NPNTransform& transform, const std::vector<QMCImplicant>& finalTerm)
+{
+	std::vector<QMCCube> cubes;
+	for (const QMCImplicant& implicant : finalTerm)
+		cubes.push_back(transformCube(implicant.variableCube(), transform, true));
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if (this->terms.size() >= NPN_CACHE_MAX_ENTRIES) return;
+	this->terms.emplace(key, std::move(cubes));
+}
+
+size_t NPNCache::size()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->terms.size();
+}
@@ -0,0 +1,208 @@
+/*
+ * plaformat.cpp
+ *
+ * Reading and writing of the Berkeley PLA format, as used by espresso and other logic tools.
+ *
+ * An PLA file starts with the number of inputs (.i) and outputs (.o), followed by one cube per line.
+ * The input part of an cube has 0, 1 or - (DONT_CARE) for each input, the output part has one character per output.
+ * The cubes are kept as rows of the truth table, so an cube with DONT_CARE inputs is not expanded into its states.
+ *
+ * The meaning of the output characters depends on the type of the file (.type, fd by default):
+ * - 1 always adds the cube to the ON-set of the output
+ * - 0 adds the cube to the OFF-set for the types fr and fdr, otherwise it has no meaning
+ * - - adds the cube to the DONT_CARE set for the types fd and fdr, otherwise it has no meaning
+ * - ~ has no meaning
+ * Cubes without meaning for an output are UNDEFINED in the truth table, so they do not hide the following rows.
+ * For the types f and fd all states not in the ON-set or DONT_CARE set are FALSE, for fr and fdr they are DONT_CARE.
+ * An output with phase 0 (.phase) is complemented, its ON-set and OFF-set are swapped while reading.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <stdio.h>
+#include <map>
+#include <algorithm>
+#include "plaformat.hpp"
+
+bool is_pla_file(const std::string& path)
+{
+	return path.size() >= 4 && (path.ends_with(".pla") || path.ends_with(".PLA"));
+}
+
+bool parse_pla(std::string_view plaStr, std::vector<TriStateBool>& values, unsigned int& inputs, unsigned int& outputs, TriStateBool& undefinedValue)
+{
+	inputs = 0;
+	outputs = 0;
+	bool offSet = false;
+	bool dcSet = true;
+	std::string phase;
+	bool cubesRead = false;
+	size_t line = 0;
+	size_t pos = 0;
+	std::string cube;
+	while (pos < plaStr.size())
+	{
+
+		size_t lineEnd = plaStr.find('\n', pos);
+		if (lineEnd == std::string_view::npos) lineEnd = plaStr.size();
+		std::string_view lineStr = plaStr.substr(pos, lineEnd - pos);
+		pos = lineEnd + 1;
+		line++;
+
+		// remove comments and surrounding whitespace
+		size_t comment = lineStr.find('#');
+		if (comment != std::string_view::npos) lineStr = lineStr.substr(0, comment);
+		size_t begin = lineStr.find_first_not_of(" \t\r");
+		if (begin == std::string_view::npos) continue;
+		lineStr = lineStr.substr(begin, lineStr.find_last_not_of(" \t\r") + 1 - begin);
+
+		if (lineStr[0] == '.')
+		{
+			size_t split = lineStr.find_first_of(" \t");
+			std::string_view keyword = lineStr.substr(0, split);
+			std::string_view argument = split == std::string_view::npos ? std::string_view() : lineStr.substr(lineStr.find_first_not_of(" \t", split));
+			if (keyword == ".e" || keyword == ".end") break;
+
+			if (keyword == ".i" || keyword == ".o")
+			{
+				unsigned int n = 0;
+				for (char c : argument)
+				{
+					if (c < '0' || c > '9') { n = 0; break; }
+					n = n * 10 + (c - '0');
+				}
+				if (n == 0)
+				{
+					wprintf(L"[!] PLA line %zu: invalid number for %.*s!\n", line, static_cast<int>(keyword.size()), keyword.data());
+					return false;
+				}
+				(keyword == ".i" ? inputs : outputs) = n;
+			}
+			else if (keyword == ".type")
+			{
+				if (argument != "f" && argument != "fd" && argument != "fr" && argument != "fdr")
+				{
+					wprintf(L"[!] PLA line %zu: unsupported type %.*s!\n", line, static_cast<int>(argument.size()), argument.data());
+					return false;
+				}
+				offSet = argument.find('r') != std::string_view::npos;
+				dcSet = argument.find('d') != std::string_view::npos;
+			}
+			else if (keyword == ".phase")
+			{
+				if (cubesRead || outputs == 0 || argument.size() != outputs || argument.find_first_not_of("01") != std::string_view::npos)
+				{
+					wprintf(L"[!] PLA line %zu: .phase needs one 0 or 1 per output, after .o and before the first cube!\n", line);
+					return false;
+				}
+				phase = argument;
+			}
+			// the other keywords (.p, .ilb, .ob ...) do not change the function
+			continue;
+		}
+
+		if (inputs == 0 || outputs == 0)
+		{
+			wprintf(L"[!] PLA line %zu: cube before the number of inputs and outputs (.i and .o) was defined!\n", line);
+			return false;
+		}
+
+		// the input and output part may be separated by whitespace, or written as one word
+		cube.clear();
+		for (char c : lineStr)
+			if (c != ' ' && c != '\t' && c != '|')
+				cube.push_back(c);
+		if (cube.size() != inputs + outputs)
+		{
+			wprintf(L"[!] PLA line %zu: cube has %zu columns, expected %u!\n", line, cube.size(), inputs + outputs);
+			return false;
+		}
+
+		cubesRead = true;
+		for (size_t column = 0; column < cube.size(); column++)
+		{
+			char c = cube[column];
+			bool input = column < inputs;
+			TriStateBool value;
+			if (c == '1')
+				value = TriStateBool::TRUE;
+			else if (c == '0')
+				value = input || offSet ? TriStateBool::FALSE : TriStateBool::UNDEFINED;
+			else if (c == '-')
+				value = input || dcSet ? TriStateBool::DONT_CARE : TriStateBool::UNDEFINED;
+			else if (c == '~' && !input)
+				value = TriStateBool::UNDEFINED;
+			else
+			{
+				wprintf(L"[!] PLA line %zu: invalid character '%c' in column %zu!\n", line, c, column + 1);
+				return false;
+			}
+			if (!input && !phase.empty() && phase[column - inputs] == '0')
+				value = value == TriStateBool::TRUE ? TriStateBool::FALSE : value == TriStateBool::FALSE ? TriStateBool::TRUE : value;
+			values.push_back(value);
+		}
+
+	}
+
+	if (inputs == 0 || outputs == 0)
+	{
+		wprintf(L"[!] PLA file does not define the number of inputs and outputs (.i and .o)!\n");
+		return false;
+	}
+	undefinedValue = offSet ? TriStateBool::DONT_CARE : TriStateBool::FALSE;
+
+	// for the types f and fd the states not covered by any cube are TRUE for an complemented output,
+	// since the first matching row defines the value, an last row covering all states sets this only for the remaining states
+	if (!offSet && phase.find('0') != std::string::npos)
+	{
+		values.insert(values.end(), inputs, TriStateBool::DONT_CARE);
+		for (unsigned int o = 0; o < outputs; o++)
+			values.push_back(phase[o] == '0' ? TriStateBool::TRUE : TriStateBool::UNDEFINED);
+	}
+	return true;
+}
+
+void format_pla(const std::vector<std::vector<QMCImplicant>>& finalTerms, const std::vector<bool>& complemented, unsigned int inputs, std::wstring& out)
+{
+	// implicants used by multiple outputs are written once, with all of their outputs set
+	std::vector<QMCCube> cubes;
+	std::map<std::pair<uint64_t, uint64_t>, unsigned int> cubeIndex;
+	std::vector<std::vector<bool>> cubeOutputs;
+	for (unsigned int o = 0; o < finalTerms.size(); o++)
+		for (const QMCImplicant& implicant : finalTerms[o])
+		{
+			const QMCCube& cube = implicant.variableCube();
+			auto entry = cubeIndex.try_emplace({ cube.value, cube.mask }, cubes.size());
+			if (entry.second)
+			{
+				cubes.push_back(cube);
+				cubeOutputs.emplace_back(finalTerms.size(), false);
+			}
+			cubeOutputs[entry.first->second][o] = true;
+		}
+
+	wchar_t header[64];
+	swprintf(header, 64, L".i %u\n.o %zu\n", inputs, finalTerms.size());
+	out += header;
+	if (std::find(complemented.begin(), complemented.end(), true) != complemented.end())
+	{
+		// the cubes of an complemented output describe its OFF-set (phase 0)
+		out += L".phase ";
+		for (unsigned int o = 0; o < finalTerms.size(); o++)
+			out += complemented[o] ? L'0' : L'1';
+		out += L"\n";
+	}
+	swprintf(header, 64, L".p %zu\n", cubes.size());
+	out += header;
+	for (unsigned int c = 0; c < cubes.size(); c++)
+	{
+		for (unsigned int i = 0; i < inputs; i++)
+			out += !(cubes[c].mask & (1ULL << i)) ? L'-' : (cubes[c].value & (1ULL << i)) ? L'1' : L'0';
+		out += L' ';
+		for (unsigned int o = 0; o < finalTerms.size(); o++)
+			out += cubeOutputs[c][o] ? L'1' : L'0';
+		out += L'\n';
+	}
+	out += L".e\n";
+}
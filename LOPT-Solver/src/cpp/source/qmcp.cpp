@@ -4,67 +4,117 @@
  * Implementation of the "QuineMcCluskey" algorithm to find the minal boolean equations for the truth table.
  * This is the code that does the actual processing.
  *
- * It also uses an modified version of the "Petrick's method" algorithm for the final solution of the prime chart.
+ * The final solution of the prime chart is found with an branch and bound search for the cheapest cover (see coversolver.cpp).
+ * Alternatively an modified version of the "Petrick's method" algorithm can be used for this.
  * The modification mainly is in the way the equations are processed.
  *
+ * Multiple outputs can be solved together, in this case each implicant is tagged with the outputs it is an implicant of.
+ * Implicants are only merged for their common outputs, so the prime chart contains terms which can be shared between outputs.
+ *
  *  Created on: 18.09.2025
  *      Author: Marvin K. (M_Marvin)
  */
 
 #include <cstring>
 #include <algorithm>
+#include <bit>
 #include <set>
 #include "qmcp.hpp"
 
+/** QMC Cube **/
+
+size_t QMCCubeHash::operator()(const QMCCube& cube) const
+{
+	// mix both words, the mask alone is the same for most implicants within one group
+	uint64_t h = cube.value * 0x9E3779B97F4A7C15ULL;
+	h ^= (cube.mask + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2));
+	return static_cast<size_t>(h ^ (h >> 32));
+}
+
+size_t QMCImplicantKeyHash::operator()(const QMCImplicantKey& key) const
+{
+	return QMCCubeHash()(key.cube) ^ static_cast<size_t>(key.outputs * 0xC2B2AE3D27D4EB4FULL);
+}
+
 /** QMC Implicant **/
 
-void QMCImplicant::initialize(KVMap& map, unsigned int column, unsigned int row)
+void QMCImplicant::initialize(uint64_t state, unsigned int variables, bool dontCare)
 {
-	for (unsigned int i = 0; i < map.variableCount(); i++)
-	{
-		this->states.push_back(map.inputAt(column, row, i));
-	}
-	// generate id for this minterm based on position in KV-map
-	// note: we want to skip ids for DONT CARE terms, to make keep them out of the final prime chart
-	if (map.valueAt(column, row) != TriStateBool::DONT_CARE)
-		this->minterms.push_back(row * map.mapWidth() + column);
+	initialize(state, variables, 1, dontCare);
+}
+
+void QMCImplicant::initialize(uint64_t state, unsigned int variables, uint64_t outputs, bool dontCare)
+{
+	this->variables = variables;
+	this->states.mask = variables >= 64 ? ~0ULL : (1ULL << variables) - 1;
+	this->states.value = state & this->states.mask;
+	this->outputs = outputs;
+	// note: we want to skip DONT CARE terms, to make keep them out of the final prime chart
+	this->minterms = dontCare ? 0 : 1;
 }
 
-std::optional<QMCImplicant> QMCImplicant::tryMerge(const QMCImplicant& implicant)
+void QMCImplicant::initialize(const QMCCube& cube, unsigned int variables)
 {
-	if (implicant.states.size() != this->states.size()) return std::nullopt;
+	this->variables = variables;
+	this->states.mask = cube.mask;
+	this->states.value = cube.value & cube.mask;
+	// note: implicants not created by merging minterms do not track the number of minterms they cover
+	this->minterms = 0;
+}
 
+std::optional<QMCImplicant> QMCImplicant::tryMerge(const QMCImplicant& implicant) const
+{
 	// test if the two implicants can be merged, this is the case if they only differ in one digit
-	unsigned int mergeIndex = this->states.size();
-	for (unsigned int i = 0; i < this->states.size(); i++)
-	{
-		if (this->states[i] == TriStateBool::DONT_CARE ^ implicant.states[i] == TriStateBool::DONT_CARE) return std::nullopt;
-		if (this->states[i] != implicant.states[i])
-		{
-			if (mergeIndex != this->states.size()) return std::nullopt;
-			mergeIndex = i;
-		}
-	}
+	// the DONT_CARE positions have to match exactly, and exactly one of the relevant values may differ
+	if (implicant.states.mask != this->states.mask) return std::nullopt;
+	uint64_t difference = this->states.value ^ implicant.states.value;
+	if (std::popcount(difference) != 1) return std::nullopt;
+	// the merged implicant is only an implicant of the outputs both of them are implicants of
+	if ((this->outputs & implicant.outputs) == 0) return std::nullopt;
 
 	// merge the two implicants into a new one, set the one digit that differs to DONT_CARE
+	// the minterms covered by the two implicants are disjoint, since they differ in one relevant digit
 	QMCImplicant merged = *this;
-	merged.states[mergeIndex] = TriStateBool::DONT_CARE;
-	for (auto m : implicant.minterms)
-		if (std::find(merged.minterms.begin(), merged.minterms.end(), m) == merged.minterms.end())
-			merged.minterms.push_back(m);
+	merged.states.mask &= ~difference;
+	merged.states.value &= ~difference;
+	merged.outputs &= implicant.outputs;
+	merged.minterms += implicant.minterms;
 	return merged;
 }
 
-const std::vector<TriStateBool>& QMCImplicant::variableStates() const
+const QMCCube& QMCImplicant::variableCube() const
 {
 	return this->states;
 }
 
-const std::vector<unsigned int>& QMCImplicant::mintermSet() const
+uint64_t QMCImplicant::outputMask() const
+{
+	return this->outputs;
+}
+
+bool QMCImplicant::coversOutput(unsigned int output) const
+{
+	return output < 64 && (this->outputs & (1ULL << output));
+}
+
+TriStateBool QMCImplicant::variableState(unsigned int input) const
+{
+	if (input >= this->variables) return TriStateBool::DONT_CARE;
+	if (!(this->states.mask & (1ULL << input))) return TriStateBool::DONT_CARE;
+	return (this->states.value & (1ULL << input)) ? TriStateBool::TRUE : TriStateBool::FALSE;
+}
+
+unsigned int QMCImplicant::mintermCount() const
 {
 	return this->minterms;
 }
 
+bool QMCImplicant::covers(const QMCMinterm& minterm) const
+{
+	// the covered minterms are implicitly defined by the cube, all relevant digits have to match
+	return coversOutput(minterm.output) && ((minterm.state ^ this->states.value) & this->states.mask) == 0;
+}
+
 void QMCImplicant::markPrime(bool prime)
 {
 	this->prime = prime;
@@ -77,69 +127,95 @@ bool QMCImplicant::isPrime() const
 
 bool QMCImplicant::operator==(const QMCImplicant& other) const
 {
-	return this->states == other.states;
+	return this->states == other.states && this->outputs == other.outputs;
 }
 bool QMCImplicant::operator!=(const QMCImplicant& other) const
 {
-	return this->states != other.states;
+	return !(*this == other);
 }
 
 unsigned int QMCImplicant::inputsTrueCount() const
 {
-	unsigned int numberOfOnes = 0;
-	for (TriStateBool s : this->states)
-		if (s == TriStateBool::TRUE) numberOfOnes++;
-	return numberOfOnes;
+	return std::popcount(this->states.value);
 }
 
 unsigned int QMCImplicant::relevantInputCount() const
 {
-	unsigned int relevantInputs = 0;
-	for (TriStateBool s : this->states)
-		if (s != TriStateBool::DONT_CARE) relevantInputs++;
-	return relevantInputs;
+	return std::popcount(this->states.mask);
 }
 
 unsigned int QMCImplicant::variableCount() const
 {
-	return this->states.size();
+	return this->variables;
 }
 
 /** QMC Implicant Set **/
 
-void QMCImplicantSet::add(const QMCImplicant& implicant)
+QMCImplicantSet::QMCImplicantSet(std::pmr::memory_resource* arena) : implicants(arena), index(arena), columns(arena) {}
+
+bool QMCImplicantSet::add(const QMCImplicant& implicant)
 {
-	if (std::find(this->implicants.begin(), this->implicants.end(), implicant) != this->implicants.end())
-		return;
+	// the index only serves the duplicate check, the vector keeps the insertion order for printing and the prime chart
+	if (!this->index.insert({ implicant.variableCube(), implicant.outputMask() }).second)
+		return false;
 	this->implicants.push_back(implicant);
+	this->columns.push(implicant.variableCube().mask, implicant.variableCube().value, implicant.outputMask());
+	return true;
 }
 
-bool QMCImplicantSet::tryMerge(QMCImplicantSet& implicantSet, std::vector<QMCImplicantSet>& targetVector)
+void QMCImplicantSet::merge(const QMCImplicantSet& implicantSet, unsigned int begin, unsigned int end, QMCMergeResult& result) const
 {
-	// try to merge all implicants within this set with each other and fill the target vector with the resulting sets
-	bool hasMerged = false;
-	for (QMCImplicant& im1 : this->implicants)
+	// try to merge the implicants [begin, end) of this set with all implicants of the other set
+	// this does not modify the sets, so multiple merges can run in parallel, the results are applied afterwards
+	result.merged.clear();
+	result.attempts = static_cast<uint64_t>(end - begin) * implicantSet.implicants.size();
+	result.mergedFirst.assign(end - begin, false);
+	result.mergedSecond.assign(implicantSet.implicants.size(), false);
+	// the merge kernel tests an whole block of the other set at once, only the partners it found are merged
+	for (unsigned int i1 = begin; i1 < end; i1++)
 	{
-		for (QMCImplicant& im2 : implicantSet.implicants)
+		const QMCCube& cube = this->implicants[i1].variableCube();
+		for (unsigned int block = 0; block < implicantSet.columns.size(); block += QMC_MERGE_BLOCK_SIZE)
 		{
-			std::optional<QMCImplicant> merged = im1.tryMerge(im2);
-			if (merged.has_value())
+			uint64_t partners = merge_partners(cube.mask, cube.value, this->implicants[i1].outputMask(), implicantSet.columns, block, QMC_MERGE_BLOCK_SIZE);
+			for (; partners != 0; partners &= partners - 1)
 			{
-				// by default every implicant is marked as prime, this will be removed here if it was merged at least once
-				im1.markPrime(false);
-				im2.markPrime(false);
+				unsigned int i2 = block + std::countr_zero(partners);
+				std::optional<QMCImplicant> merged = this->implicants[i1].tryMerge(implicantSet.implicants[i2]);
+				if (!merged.has_value()) continue;
+
+				// by default every implicant is marked as prime, this will be removed later if it was merged at least once
+				// an implicant of multiple outputs is only replaced by the merged one, if it is still an implicant of all of them
+				if (merged->outputMask() == this->implicants[i1].outputMask())
+					result.mergedFirst[i1 - begin] = true;
+				if (merged->outputMask() == implicantSet.implicants[i2].outputMask())
+					result.mergedSecond[i2] = true;
 				merged->markPrime(true);
-
-				unsigned int numberOfOnes = merged->inputsTrueCount();
-				targetVector.at(numberOfOnes).add(merged.value());
-				hasMerged = true;
+				result.merged.push_back(merged.value());
 			}
 		}
 	}
-	return hasMerged;
 }
 
-const std::vector<QMCImplicant>& QMCImplicantSet::implicantSet() const
+void QMCImplicantSet::reserve(unsigned int implicants)
+{
+	this->implicants.reserve(implicants);
+	this->columns.reserve(implicants);
+}
+
+void QMCImplicantSet::markMerged(const std::vector<bool>& merged, unsigned int begin)
+{
+	for (unsigned int i = 0; i < merged.size(); i++)
+		if (merged[i])
+			this->implicants.at(begin + i).markPrime(false);
+}
+
+unsigned int QMCImplicantSet::size() const
+{
+	return this->implicants.size();
+}
+
+const std::pmr::vector<QMCImplicant>& QMCImplicantSet::implicantSet() const
 {
 	return this->implicants;
 }
@@ -152,49 +228,181 @@ unsigned int QMCImplicantSet::variableCount() const
 
 /** QMC Stack **/
 
-void QMCStack::initialize(KVMap& map)
+QMCStack::QMCStack() : stages(&this->arena) {}
+
+std::pmr::vector<QMCImplicantSet>& QMCStack::addStage(unsigned int sets)
+{
+	// the sets are constructed in place and never reallocated, their containers allocate from the arena as well
+	std::pmr::vector<QMCImplicantSet>& implicantSets = this->stages.emplace_back();
+	implicantSets.reserve(sets);
+	for (unsigned int i = 0; i < sets; i++)
+		implicantSets.emplace_back(&this->arena);
+	return implicantSets;
+}
+
+uint64_t stateFromId(unsigned int id, unsigned int variables)
+{
+	// the id is the index of the state in the fully defined truth table, so the first input is the most significant bit
+	uint64_t state = 0;
+	for (unsigned int i = 0; i < variables; i++)
+		if (id & (1U << (variables - 1 - i)))
+			state |= 1ULL << i;
+	return state;
+}
+
+void QMCStack::initialize(const TruthTable& table, unsigned int output)
 {
 
-	this->stages.clear();
-	std::vector<QMCImplicantSet>& implicantSets = this->stages.emplace_back();;
+	// the stages of an previous function are dropped before the arena they were allocated from is released
+	this->stages = std::pmr::vector<std::pmr::vector<QMCImplicantSet>>(&this->arena);
+	this->arena.release();
+	this->minterms.clear();
+	this->counters = {};
 
-	for (unsigned int i = 0; i <= map.variableCount(); i++)
-		implicantSets.emplace_back();
+	unsigned int variables = table.inputCount();
+	std::pmr::vector<QMCImplicantSet>& implicantSets = this->addStage(variables + 1);
 
-	for (unsigned int row = 0; row < map.mapHeight(); row++)
-		for (unsigned int column = 0; column < map.mapWidth(); column++)
-		{
+	// get all states of the function which evaluate to TRUE or DONT_CARE, including the ones omitted in the table
+	BitSet onSet, dcSet;
+	table.outputSets(output, onSet, dcSet);
+	BitSet implicantStates = onSet;
+	implicantStates |= dcSet;
 
-			if (map.valueAt(column, row) == TriStateBool::FALSE) continue;
+	for (unsigned int id = implicantStates.next(0); id < implicantStates.size(); id = implicantStates.next(id + 1))
+	{
 
-			QMCImplicant implicant;
-			implicant.initialize(map, column, row);
-			unsigned int numberOfOnes = implicant.inputsTrueCount();
+		uint64_t state = stateFromId(id, variables);
 
-			implicantSets.at(numberOfOnes).add(implicant);
+		QMCImplicant implicant;
+		implicant.initialize(state, variables, dcSet.test(id));
+		unsigned int numberOfOnes = implicant.inputsTrueCount();
 
-		}
+		implicantSets.at(numberOfOnes).add(implicant);
+
+		// DONT CARE terms are not included in the prime chart
+		if (implicant.mintermCount() > 0)
+			this->minterms.push_back({ id, state });
+
+	}
 
 }
 
-bool QMCStack::tryMerge()
+void QMCStack::initialize(const TruthTable& table)
 {
-	unsigned int nextStage = this->stages.size();
 
-	// create new stage vector
-	std::vector<QMCImplicantSet>& stage2Set = this->stages.emplace_back();
-	std::vector<QMCImplicantSet>& stage1Set = this->stages.at(this->stages.size() - 2);
+	// the stages of an previous function are dropped before the arena they were allocated from is released
+	this->stages = std::pmr::vector<std::pmr::vector<QMCImplicantSet>>(&this->arena);
+	this->arena.release();
+	this->minterms.clear();
+	this->counters = {};
+
+	unsigned int variables = table.inputCount();
+	std::pmr::vector<QMCImplicantSet>& implicantSets = this->addStage(variables + 1);
+
+	// get the states which evaluate to TRUE or DONT_CARE for each of the outputs
+	std::vector<BitSet> onSets(table.outputCount());
+	std::vector<BitSet> dcSets(table.outputCount());
+	for (unsigned int o = 0; o < table.outputCount(); o++)
+		table.outputSets(o, onSets[o], dcSets[o]);
+
+	// the sets cover all states of the inputs, check_table() limits the shared terms to the inputs the QMC engine can enumerate
+	unsigned int states = onSets.empty() ? 0 : onSets[0].size();
+	for (unsigned int id = 0; id < states; id++)
+	{
+
+		// tag the state with all outputs it is an implicant of
+		uint64_t outputs = 0;
+		uint64_t dontCareOutputs = 0;
+		for (unsigned int o = 0; o < table.outputCount(); o++)
+		{
+			if (onSets[o].test(id))
+				outputs |= 1ULL << o;
+			else if (dcSets[o].test(id))
+			{
+				outputs |= 1ULL << o;
+				dontCareOutputs |= 1ULL << o;
+			}
+		}
+		if (outputs == 0) continue;
+
+		uint64_t state = stateFromId(id, variables);
+
+		QMCImplicant implicant;
+		implicant.initialize(state, variables, outputs, outputs == dontCareOutputs);
+		implicantSets.at(implicant.inputsTrueCount()).add(implicant);
+
+		// the state is an separate minterm for each output it is TRUE for
+		for (unsigned int o = 0; o < table.outputCount(); o++)
+			if (onSets[o].test(id))
+				this->minterms.push_back({ id, state, o });
 
-	for (unsigned int i = 0; i < stage1Set.size(); i++) {
-		stage2Set.emplace_back();
 	}
 
-	// try to merge all sets in the current stage with each other, place resulting sets into new stage
-	bool hasMerged = false;
+}
+
+bool QMCStack::tryMerge(ThreadPool* pool)
+{
+	// create new stage vector, the stages vector only holds the set vectors, so the sets keep their addresses
+	std::pmr::vector<QMCImplicantSet>& stage2Set = this->addStage(this->stages.back().size());
+	std::pmr::vector<QMCImplicantSet>& stage1Set = this->stages.at(this->stages.size() - 2);
+
+	// split the merges of each set with its neighbor into tasks, each task collects its results into its own buffer
+	// the buffers are reused from the previous stages and only grow if an task finds more merges than any before
+	struct MergeTask {
+		unsigned int set;
+		unsigned int begin;
+		unsigned int end;
+		QMCMergeResult* result;
+	};
+	std::vector<MergeTask> tasks;
 	for (unsigned int i = 0; i < stage1Set.size() - 1; i++)
+		for (unsigned int begin = 0; begin < stage1Set.at(i).size(); begin += QMC_MERGE_TASK_SIZE)
+			tasks.push_back({ i, begin, std::min(begin + QMC_MERGE_TASK_SIZE, stage1Set.at(i).size()), nullptr });
+	if (this->mergeResults.size() < tasks.size())
+		this->mergeResults.resize(tasks.size());
+	for (unsigned int i = 0; i < tasks.size(); i++)
+		tasks[i].result = &this->mergeResults[i];
+
+	// try to merge all sets in the current stage with each other
+	if (pool != nullptr && tasks.size() > 1)
+	{
+		for (MergeTask& task : tasks)
+			pool->submit([&task, &stage1Set]() {
+				stage1Set.at(task.set).merge(stage1Set.at(task.set + 1), task.begin, task.end, *task.result);
+			});
+		pool->wait();
+	}
+	else
+	{
+		for (MergeTask& task : tasks)
+			stage1Set.at(task.set).merge(stage1Set.at(task.set + 1), task.begin, task.end, *task.result);
+	}
+
+	// the sets of the new stage are reserved for all merged implicants including duplicates,
+	// the arena does not reuse the memory of an vector that grows, and large reserved blocks are only backed by memory once written
+	std::vector<unsigned int> mergedCount(stage2Set.size(), 0);
+	for (MergeTask& task : tasks)
+		for (const QMCImplicant& merged : task.result->merged)
+			mergedCount[merged.inputsTrueCount()]++;
+	for (unsigned int i = 0; i < stage2Set.size(); i++)
+		stage2Set[i].reserve(mergedCount[i]);
+
+	// apply the results in task order, so the new stage is the same regardless of the number of threads
+	// the prime flags are only cleared here, since an set is shared between the tasks of both its neighbors
+	bool hasMerged = false;
+	for (MergeTask& task : tasks)
 	{
-		if (stage1Set.at(i).tryMerge(stage1Set.at(i + 1), stage2Set))
+		stage1Set.at(task.set).markMerged(task.result->mergedFirst, task.begin);
+		stage1Set.at(task.set + 1).markMerged(task.result->mergedSecond, 0);
+		this->counters.mergeAttempts += task.result->attempts;
+		this->counters.merges += task.result->merged.size();
+		for (const QMCImplicant& merged : task.result->merged)
+		{
+			unsigned int numberOfOnes = merged.inputsTrueCount();
+			if (!stage2Set.at(numberOfOnes).add(merged))
+				this->counters.duplicates++;
 			hasMerged = true;
+		}
 	}
 	return hasMerged;
 }
@@ -210,10 +418,15 @@ unsigned int QMCStack::groupImplicantCount(unsigned int numberOfOnes) const
 	return n;
 }
 
+const std::vector<QMCMinterm>& QMCStack::mintermSet() const
+{
+	return this->minterms;
+}
+
 unsigned int QMCStack::variableCount() const
 {
 	if (this->stages.empty()) return 0;
-	for (auto s : *this->stages.begin())
+	for (const QMCImplicantSet& s : *this->stages.begin())
 		if (s.variableCount() > 0) return s.variableCount();
 	return 0;
 }
@@ -223,6 +436,11 @@ unsigned int QMCStack::stageCount() const
 	return this->stages.size();
 }
 
+const QMCStackCounters& QMCStack::workCounters() const
+{
+	return this->counters;
+}
+
 std::optional<std::reference_wrapper<const QMCImplicantSet>> QMCStack::implicantSetFor(unsigned int stage, unsigned int numberOfOnes) const
 {
 	if (stage >= this->stages.size()) return std::nullopt;
@@ -234,149 +452,348 @@ std::optional<std::reference_wrapper<const QMCImplicantSet>> QMCStack::implicant
 
 void QMCPrimeChart::initialize(const QMCStack& stack)
 {
+	this->primes.clear();
 	for (unsigned int stage = 0; stage < stack.stageCount(); stage++)
-		for (unsigned int numberOfOnes = 0; numberOfOnes < stack.variableCount(); numberOfOnes++)
+		for (unsigned int numberOfOnes = 0; numberOfOnes <= stack.variableCount(); numberOfOnes++)
 		{
 			QMCImplicantSetOpt implicants = stack.implicantSetFor(stage, numberOfOnes);
+			if (!implicants.has_value()) continue;
 			for (auto implicant = implicants->get().implicantSet().begin(); implicant != implicants->get().implicantSet().end(); implicant++)
-				if (implicant->isPrime() && !implicant->mintermSet().empty())
-				{
+				if (implicant->isPrime() && implicant->mintermCount() > 0)
 					this->primes.push_back(*implicant);
-					for (auto mintermId = implicant->mintermSet().begin(); mintermId != implicant->mintermSet().end(); mintermId++)
-						if (std::find(this->minterms.begin(), this->minterms.end(), *mintermId) == this->minterms.end())
-							this->minterms.push_back(*mintermId);
-				}
 		}
+
+	// every minterm of the function is covered by at least one prime, so the chart columns are just the minterms of the stack
+	this->minterms = stack.mintermSet();
+	std::sort(this->minterms.begin(), this->minterms.end(), [](const QMCMinterm& a, const QMCMinterm& b) {
+		return a.output != b.output ? a.output < b.output : a.id < b.id;
+	});
+
+	updateCoverage();
 }
 
-void QMCPrimeChart::extractEPIs(std::vector<QMCImplicant>& essentialPrimes)
+void QMCPrimeChart::initialize(const std::vector<QMCImplicant>& primes, const std::vector<QMCMinterm>& minterms)
 {
-	// find all essential primes, these are the ones which are the only ones which fulfill certain minterms in the table
-	for (auto minterm = this->minterms.begin(); minterm != this->minterms.end(); minterm++)
-	{
-		std::vector<QMCImplicant>::iterator epi = this->primes.end();
-		for (auto primeImplicant = this->primes.begin(); primeImplicant != this->primes.end(); primeImplicant++) {
-			if (std::find(primeImplicant->mintermSet().begin(), primeImplicant->mintermSet().end(), *minterm) != primeImplicant->mintermSet().end())
-				if (epi != this->primes.end())
-					goto not_essential;
-				else
-					epi = primeImplicant;
+	// used by engines which compute the primes without an implicant stack, the minterms only have to be covered by the same primes as the function
+	this->primes = primes;
+	this->minterms = minterms;
+	updateCoverage();
+}
+
+void QMCPrimeChart::updateCoverage()
+{
+	// build one bit set per prime, marking the chart columns (minterms) it covers
+	this->coverage.assign(this->primes.size(), BitSet(this->minterms.size()));
+	for (unsigned int p = 0; p < this->primes.size(); p++)
+		for (unsigned int m = 0; m < this->minterms.size(); m++)
+			if (this->primes[p].covers(this->minterms[m]))
+				this->coverage[p].set(m);
+}
+
+void QMCPrimeChart::removeEntries(const BitSet& removedPrimes, const BitSet& removedMinterms)
+{
+	std::vector<QMCImplicant> remainingPrimes;
+	for (unsigned int p = 0; p < this->primes.size(); p++)
+		if (!removedPrimes.test(p))
+			remainingPrimes.push_back(this->primes[p]);
+	this->primes = remainingPrimes;
+
+	std::vector<QMCMinterm> remainingMinterms;
+	for (unsigned int m = 0; m < this->minterms.size(); m++)
+		if (!removedMinterms.test(m))
+			remainingMinterms.push_back(this->minterms[m]);
+	this->minterms = remainingMinterms;
+
+	updateCoverage();
+}
+
+unsigned int QMCPrimeChart::extractEPIs(std::vector<QMCImplicant>& essentialPrimes)
+{
+	// count for each minterm by how many primes it is covered, and remember the last of them
+	std::vector<unsigned int> coverCount(this->minterms.size(), 0);
+	std::vector<unsigned int> coveringPrime(this->minterms.size(), 0);
+	for (unsigned int p = 0; p < this->primes.size(); p++)
+		for (unsigned int m = this->coverage[p].next(0); m < this->minterms.size(); m = this->coverage[p].next(m + 1))
+		{
+			coverCount[m]++;
+			coveringPrime[m] = p;
 		}
 
-		if (epi != this->primes.end() && std::find(essentialPrimes.begin(), essentialPrimes.end(), *epi) == essentialPrimes.end())
-			essentialPrimes.push_back(*epi);
-		not_essential:
+	// find all essential primes, these are the ones which are the only ones which fulfill certain minterms in the table
+	BitSet essential(this->primes.size());
+	BitSet covered(this->minterms.size());
+	unsigned int extracted = 0;
+	for (unsigned int m = 0; m < this->minterms.size(); m++)
+	{
+		if (coverCount[m] != 1 || essential.test(coveringPrime[m])) continue;
+		essential.set(coveringPrime[m]);
+		covered |= this->coverage[coveringPrime[m]];
+		essentialPrimes.push_back(this->primes[coveringPrime[m]]);
+		extracted++;
 	}
 
-	// remove essential primes from the chart
-	this->primes.erase(std::remove_if(this->primes.begin(), this->primes.end(), [essentialPrimes](const QMCImplicant& pi){
-		return std::find(essentialPrimes.begin(), essentialPrimes.end(), pi) != essentialPrimes.end();
-	}), this->primes.end());
-
-	// remove all minterms fulfilled by the primes
-	this->minterms.erase(std::remove_if(this->minterms.begin(), this->minterms.end(), [essentialPrimes](unsigned int m){
-		for (const QMCImplicant& epi : essentialPrimes)
-			if (std::find(epi.mintermSet().begin(), epi.mintermSet().end(), m) != epi.mintermSet().end())
-				return true;
-		return false;
-	}), this->minterms.end());
+	// remove essential primes and all minterms fulfilled by them from the chart
+	if (extracted > 0)
+		removeEntries(essential, covered);
+	return extracted;
 }
 
-typedef std::set<const QMCImplicant*> term_t;
-typedef std::vector<term_t> bracket_t;
-
-bracket_t mergeBrackets(const std::vector<bracket_t>& brackets)
+unsigned int QMCPrimeChart::removeDominatedPrimes()
 {
+	// an prime is not needed if another prime covers at least the same minterms for at most the same cost
+	// primes which do not cover any minterm anymore are removed as well
+	BitSet dominated(this->primes.size());
+	unsigned int removed = 0;
+	for (unsigned int p1 = 0; p1 < this->primes.size(); p1++)
+	{
+		bool isDominated = !this->coverage[p1].any();
+		for (unsigned int p2 = 0; p2 < this->primes.size() && !isDominated; p2++)
+		{
+			if (p1 == p2 || dominated.test(p2)) continue;
+			if (this->primes[p2].relevantInputCount() > this->primes[p1].relevantInputCount()) continue;
+			if (!this->coverage[p2].includes(this->coverage[p1])) continue;
+			// for equal primes with equal cost keep the first one
+			if (this->primes[p2].relevantInputCount() == this->primes[p1].relevantInputCount() && p2 > p1 && this->coverage[p1] == this->coverage[p2]) continue;
+			isDominated = true;
+		}
+		if (!isDominated) continue;
+		dominated.set(p1);
+		removed++;
+	}
 
-	// copy first bracket to merge with others
-	bracket_t merged = *brackets.begin();
+	if (removed > 0)
+		removeEntries(dominated, BitSet(this->minterms.size()));
+	return removed;
+}
 
-	// calculate how many entries this merged bracket will have
-	size_t totalMergedTerms = 1;
-	for (bracket_t bracket : brackets)
-		totalMergedTerms *= bracket.size();
+unsigned int QMCPrimeChart::removeDominatingMinterms()
+{
+	// collect the primes covering each minterm
+	std::vector<BitSet> coveringPrimes(this->minterms.size(), BitSet(this->primes.size()));
+	for (unsigned int p = 0; p < this->primes.size(); p++)
+		for (unsigned int m = this->coverage[p].next(0); m < this->minterms.size(); m = this->coverage[p].next(m + 1))
+			coveringPrimes[m].set(p);
+
+	// an minterm is fulfilled automatically if another minterm is, which is only covered by an subset of its primes
+	BitSet dominating(this->minterms.size());
+	unsigned int removed = 0;
+	for (unsigned int m1 = 0; m1 < this->minterms.size(); m1++)
+	{
+		for (unsigned int m2 = 0; m2 < this->minterms.size(); m2++)
+		{
+			if (m1 == m2 || dominating.test(m2)) continue;
+			if (!coveringPrimes[m1].includes(coveringPrimes[m2])) continue;
+			// for minterms with equal primes keep the first one
+			if (m2 > m1 && coveringPrimes[m1] == coveringPrimes[m2]) continue;
+			dominating.set(m1);
+			removed++;
+			break;
+		}
+	}
 
-	// reserve space for all terms to avoid pointer invalidation
-	merged.reserve(totalMergedTerms);
+	if (removed > 0)
+		removeEntries(BitSet(this->primes.size()), dominating);
+	return removed;
+}
 
-	// merge with all following brackets
-	for (auto bracket = brackets.begin() + 1; bracket != brackets.end(); bracket++)
+unsigned int QMCPrimeChart::reduce(std::vector<QMCImplicant>& essentialPrimes)
+{
+	// removing primes can make other primes essential and removing minterms can make other primes dominated,
+	// so repeat until the chart can not be reduced any further, what remains is the cyclic core of the chart
+	unsigned int extracted = 0;
+	while (true)
 	{
+		unsigned int epis = extractEPIs(essentialPrimes);
+		extracted += epis;
+		unsigned int changes = epis;
+		changes += removeDominatedPrimes();
+		changes += removeDominatingMinterms();
+		if (changes == 0 || this->minterms.empty()) break;
+	}
+	return extracted;
+}
 
-		// merge terms of "merged" bracket with ...
-		for (auto term1 = merged.begin(); term1 != merged.end(); term1++) {
-			term_t term1tmp = *term1;
+typedef std::set<const QMCImplicant*> term_t;
+typedef std::vector<term_t> bracket_t;
 
-			// ... all terms of other bracket
-			for (auto term2 = bracket->begin(); term2 != bracket->end(); term2++)
+void eliminateSupersets(std::vector<BitSet>& products)
+{
+	// this essentially applies the absorption law to the supplied products of primes
+	// shorter products can only absorb longer ones, so each product only has to be compared with the shorter products kept so far
+	std::vector<std::pair<unsigned int, unsigned int>> order;
+	for (unsigned int i = 0; i < products.size(); i++)
+		order.push_back({ products[i].count(), i });
+	std::sort(order.begin(), order.end());
+
+	std::vector<BitSet> minimal;
+	for (auto [length, i] : order)
+	{
+		bool absorbed = false;
+		for (const BitSet& kept : minimal)
+		{
+			// also removes duplicates, since equal products include each other
+			if (products[i].includes(kept))
 			{
-
-				term1->insert(term2->begin(), term2->end());
-
-				if (term2 + 1 != bracket->end())
-					term1 = merged.insert(term1 + 1, term1tmp);
+				absorbed = true;
+				break;
 			}
 		}
+		if (!absorbed) minimal.push_back(std::move(products[i]));
 	}
+	products.swap(minimal);
+}
 
-	return merged;
-
+unsigned int productCost(const BitSet& product, const std::vector<unsigned int>& costs)
+{
+	unsigned int cost = 0;
+	for (unsigned int p = product.next(0); p < product.size(); p = product.next(p + 1))
+		cost += costs[p];
+	return cost;
 }
 
-void eliminateSupersets(bracket_t& bracket)
+void multiplyBracket(std::vector<BitSet>& products, const BitSet& sum, const std::vector<unsigned int>& costs, unsigned int costLimit)
 {
-	// this essentially applies the absorption law to the supplied terms
-	for (auto term1 = bracket.begin(); term1 != bracket.end() - 1;)
+
+	// multiply each product with the sum of primes
+	std::vector<BitSet> merged;
+	for (const BitSet& product : products)
 	{
-		for (auto term2 = term1 + 1; term2 != bracket.end();)
+
+		// if the product already contains one of the primes of the sum, all new products would be absorbed by it
+		if (product.intersects(sum))
 		{
-			if (std::includes(term1->begin(), term1->end(), term2->begin(), term2->end()))
-			{
-				// remove term1
-				term1 = bracket.erase(term1);
-				goto break_skip_increment;
-			}
-			else if (std::includes(term2->begin(), term2->end(), term1->begin(), term1->end()))
-			{
-				// remove term2
-				term2 = bracket.erase(term2);
-			}
-			else
-				term2++;
+			merged.push_back(product);
+			continue;
+		}
+
+		// products only get longer with each step, so products above the limit can never become the shortest one
+		unsigned int cost = productCost(product, costs);
+		for (unsigned int p = sum.next(0); p < sum.size(); p = sum.next(p + 1))
+		{
+			if (cost + costs[p] > costLimit) continue;
+			merged.push_back(product);
+			merged.back().set(p);
 		}
-		term1++;
-		break_skip_increment:
 	}
+
+	// apply the absorption law right away, to keep the intermediate products as few as possible
+	eliminateSupersets(merged);
+	products.swap(merged);
+
+}
+
+void QMCPrimeChart::findOptimalPrimes(std::vector<QMCImplicant>& optimalPrimes, QMCCoverMethod method, QMCCoverCounters* counters) const
+{
+	if (method == QMCCoverMethod::PETRICK)
+		findOptimalPrimesPetrick(optimalPrimes, counters);
+	else
+		findOptimalPrimesBranchAndBound(optimalPrimes, counters);
+}
+
+void QMCPrimeChart::findOptimalPrimesBranchAndBound(std::vector<QMCImplicant>& optimalPrimes, QMCCoverCounters* counters) const
+{
+
+	// the cost of an prime is the number of relevant inputs, the same as for the shortest product in Petrick's method
+	std::vector<unsigned int> costs;
+	for (const QMCImplicant& implicant : this->primes)
+		costs.push_back(implicant.relevantInputCount());
+
+	// search for the cheapest set of primes which covers all remaining minterms
+	CoverSolver solver(this->coverage, costs, this->minterms.size());
+	std::vector<unsigned int> selectedPrimes;
+	bool solved = solver.solve(selectedPrimes);
+	if (counters != nullptr)
+		counters->searchNodes += solver.nodeCount();
+	if (!solved) return;
+
+	for (unsigned int p : selectedPrimes)
+		optimalPrimes.push_back(this->primes[p]);
+
 }
 
-void QMCPrimeChart::findOptimalPrimes(std::vector<QMCImplicant>& optimalPrimes) const
+void QMCPrimeChart::findOptimalPrimesPetrick(std::vector<QMCImplicant>& optimalPrimes, QMCCoverCounters* counters) const
 {
 
 	// create an product of sums, where each sum is true if its corresponding column is true (if one of its minterms is true)
-	std::vector<bracket_t> productOfSums;
-	for (unsigned int minterm : this->minterms)
+	// each sum is stored as the set of primes covering the minterm
+	std::vector<BitSet> productOfSums;
+	for (unsigned int m = 0; m < this->minterms.size(); m++)
+	{
+		productOfSums.emplace_back(this->primes.size());
+
+		for (unsigned int p = 0; p < this->primes.size(); p++)
+			if (this->coverage[p].test(m))
+				productOfSums.back().set(p);
+	}
+
+	// an sum containing all primes of another sum is absorbed by it: (a)(a+b) = a
+	std::vector<BitSet> sums;
+	for (unsigned int s1 = 0; s1 < productOfSums.size(); s1++)
 	{
-		productOfSums.push_back({});
+		bool absorbed = false;
+		for (unsigned int s2 = 0; s2 < productOfSums.size() && !absorbed; s2++)
+		{
+			if (s1 == s2 || !productOfSums[s1].includes(productOfSums[s2])) continue;
+			// for equal sums keep the first one
+			absorbed = s2 < s1 || productOfSums[s1] != productOfSums[s2];
+		}
+		if (!absorbed) sums.push_back(productOfSums[s1]);
+	}
 
-		unsigned int id = 0;
-		for (const QMCImplicant& implicant : this->primes)
+	// the cost of an greedy cover is an upper limit for the shortest product, longer products do not have to be kept
+	std::vector<unsigned int> costs;
+	for (const QMCImplicant& implicant : this->primes)
+		costs.push_back(implicant.relevantInputCount());
+	unsigned int costLimit = 0;
+	BitSet uncovered(this->minterms.size());
+	for (unsigned int m = 0; m < this->minterms.size(); m++)
+		uncovered.set(m);
+	while (uncovered.any())
+	{
+		unsigned int bestPrime = 0;
+		unsigned int bestGain = 0;
+		for (unsigned int p = 0; p < this->primes.size(); p++)
 		{
-			if (std::find(implicant.mintermSet().begin(), implicant.mintermSet().end(), minterm) != implicant.mintermSet().end())
+			BitSet gain = this->coverage[p];
+			gain &= uncovered;
+			if (gain.count() > bestGain)
 			{
-				productOfSums.back().push_back({});
-				productOfSums.back().back().insert(&implicant);
+				bestGain = gain.count();
+				bestPrime = p;
 			}
-			id++;
 		}
+		if (bestGain == 0) return; // minterms which can not be covered
+		costLimit += costs[bestPrime];
+		uncovered.subtract(this->coverage[bestPrime]);
 	}
 
-	// merge all sums into one to create an sum of products
-	bracket_t sumOfProducts = mergeBrackets(productOfSums);
+	// multiply the sums one at a time to create an sum of products, the sums with the fewest primes first
+	// since the absorption law is applied after every step, the order does not change the final sum of products
+	std::stable_sort(sums.begin(), sums.end(), [](const BitSet& a, const BitSet& b) {
+		return a.count() < b.count();
+	});
+	std::vector<BitSet> products = { BitSet(this->primes.size()) };
+	for (const BitSet& sum : sums)
+	{
+		multiplyBracket(products, sum, costs, costLimit);
+		if (counters != nullptr)
+			counters->petrickPeakProducts = std::max<uint64_t>(counters->petrickPeakProducts, products.size());
+	}
+	if (counters != nullptr)
+	{
+		counters->petrickSums += sums.size();
+		counters->petrickProducts += products.size();
+	}
 
-	// sort and remove duplicate terms and apply absorption law
+	// convert the products back into sets of primes, sorted to choose between equally short products deterministically
+	bracket_t sumOfProducts;
+	for (const BitSet& product : products)
+	{
+		sumOfProducts.push_back({});
+		for (unsigned int p = product.next(0); p < product.size(); p = product.next(p + 1))
+			sumOfProducts.back().insert(&this->primes[p]);
+	}
 	std::sort(sumOfProducts.begin(), sumOfProducts.end());
-	sumOfProducts.erase(std::unique(sumOfProducts.begin(), sumOfProducts.end()), sumOfProducts.end());
-	eliminateSupersets(sumOfProducts);
 
 	// find shortest product in the sum of products
 	unsigned int tlen = 0;
@@ -404,11 +821,70 @@ const std::vector<QMCImplicant>& QMCPrimeChart::primeImplicants() const
 	return this->primes;
 }
 
-const std::vector<unsigned int>& QMCPrimeChart::mintermIds() const
+const std::vector<QMCMinterm>& QMCPrimeChart::mintermSet() const
 {
 	return this->minterms;
 }
 
+const BitSet& QMCPrimeChart::primeCoverage(unsigned int prime) const
+{
+	return this->coverage.at(prime);
+}
+
+bool QMCPrimeChart::covers(unsigned int prime, unsigned int minterm) const
+{
+	if (prime >= this->coverage.size()) return false;
+	return this->coverage[prime].test(minterm);
+}
+
+void QMCPrimeChart::selectOutputTerm(const std::vector<QMCImplicant>& primes, const std::vector<QMCMinterm>& minterms, unsigned int output, std::vector<QMCImplicant>& outputTerm)
+{
+
+	// collect the minterms of the output and the primes which can be used for it
+	std::vector<QMCMinterm> outputMinterms;
+	for (const QMCMinterm& minterm : minterms)
+		if (minterm.output == output)
+			outputMinterms.push_back(minterm);
+
+	std::vector<const QMCImplicant*> candidates;
+	std::vector<BitSet> coverage;
+	for (const QMCImplicant& prime : primes)
+	{
+		if (!prime.coversOutput(output)) continue;
+		BitSet covered(outputMinterms.size());
+		for (unsigned int m = 0; m < outputMinterms.size(); m++)
+			if (prime.covers(outputMinterms[m]))
+				covered.set(m);
+		if (!covered.any()) continue;
+		candidates.push_back(&prime);
+		coverage.push_back(covered);
+	}
+
+	// the primes are shared between the outputs, so an output might not need all of them
+	// remove the primes of which all minterms are covered by the others, the most expensive first
+	std::vector<unsigned int> order(candidates.size());
+	for (unsigned int i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&candidates](unsigned int a, unsigned int b) {
+		return candidates[a]->relevantInputCount() > candidates[b]->relevantInputCount();
+	});
+
+	std::vector<bool> removed(candidates.size(), false);
+	for (unsigned int i : order)
+	{
+		BitSet others(outputMinterms.size());
+		for (unsigned int j = 0; j < candidates.size(); j++)
+			if (j != i && !removed[j])
+				others |= coverage[j];
+		removed[i] = others.includes(coverage[i]);
+	}
+
+	for (unsigned int i = 0; i < candidates.size(); i++)
+		if (!removed[i])
+			outputTerm.push_back(*candidates[i]);
+
+}
+
 unsigned int QMCPrimeChart::variableCount() const
 {
 	if (this->primes.empty()) return 0;
@@ -0,0 +1,104 @@
+/*
+ * resultwriter.cpp
+ *
+ * Writes the final terms in an plain format without any console graphics, for use by other programs.
+ * The result is first formatted into an buffer and then written at once, instead of an separate write for each literal.
+ *
+ * The text format has one line per output "00 = A'E + C'E", the JSON format contains the term
+ * and the implicants as cube strings with one character per input (1, 0 or - for DONT_CARE).
+ * The PLA format contains each implicant once, with all the outputs using it (see plaformat.cpp).
+ * Outputs which are the complement of their terms are written as "01 = (A'E + C'E)'", or marked as complement in the JSON and PLA format.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <stdio.h>
+#include "resultwriter.hpp"
+#include "plaformat.hpp"
+
+void format_bool_term(const std::vector<QMCImplicant>& term, std::wstring& out)
+{
+	for (unsigned int i = 0; i < term.size(); i++)
+	{
+		if (i > 0) out += L" + ";
+		for (unsigned int input = 0; input < term[i].variableCount(); input++)
+		{
+			TriStateBool state = term[i].variableState(input);
+			if (state == TriStateBool::DONT_CARE) continue;
+			out += static_cast<wchar_t>(65 + input);
+			if (state == TriStateBool::FALSE) out += L'\'';
+		}
+	}
+}
+
+void format_json_string(const std::wstring& text, std::wstring& out)
+{
+	// the variable names continue behind Z with the following characters, input 27 is an backslash
+	for (wchar_t c : text)
+	{
+		if (c == L'"' || c == L'\\') out += L'\\';
+		out += c;
+	}
+}
+
+void format_cube(const QMCImplicant& implicant, std::wstring& out)
+{
+	for (unsigned int input = 0; input < implicant.variableCount(); input++)
+	{
+		TriStateBool state = implicant.variableState(input);
+		out += state == TriStateBool::TRUE ? L'1' : state == TriStateBool::FALSE ? L'0' : L'-';
+	}
+}
+
+void format_results(const std::vector<std::vector<QMCImplicant>>& finalTerms, const std::vector<bool>& complemented, unsigned int inputs, ResultFormat format, std::wstring& out)
+{
+	wchar_t number[16];
+	if (format == ResultFormat::PLA)
+	{
+		format_pla(finalTerms, complemented, inputs, out);
+	}
+	else if (format == ResultFormat::JSON)
+	{
+		out += L"{\n  \"outputs\": [";
+		for (unsigned int o = 0; o < finalTerms.size(); o++)
+		{
+			swprintf(number, 16, L"%u", o);
+			out += o > 0 ? L",\n" : L"\n";
+			out += L"    { \"output\": ";
+			out += number;
+			out += complemented[o] ? L", \"complement\": true, \"term\": \"" : L", \"complement\": false, \"term\": \"";
+			std::wstring term;
+			format_bool_term(finalTerms[o], term);
+			format_json_string(term, out);
+			out += L"\", \"implicants\": [";
+			for (unsigned int i = 0; i < finalTerms[o].size(); i++)
+			{
+				out += i > 0 ? L", \"" : L"\"";
+				format_cube(finalTerms[o][i], out);
+				out += L"\"";
+			}
+			out += L"] }";
+		}
+		out += L"\n  ]\n}\n";
+	}
+	else
+	{
+		for (unsigned int o = 0; o < finalTerms.size(); o++)
+		{
+			swprintf(number, 16, L"%02u = ", o);
+			out += number;
+			if (complemented[o]) out += L"(";
+			format_bool_term(finalTerms[o], out);
+			out += complemented[o] ? L")'\n" : L"\n";
+		}
+	}
+}
+
+void write_results(const std::vector<std::vector<QMCImplicant>>& finalTerms, const std::vector<bool>& complemented, unsigned int inputs, ResultFormat format)
+{
+	std::wstring out;
+	format_results(finalTerms, complemented, inputs, format, out);
+	fputws(out.c_str(), stdout);
+	fflush(stdout);
+}
@@ -0,0 +1,479 @@
+/*
+ * server.cpp
+ *
+ * Server mode of the solver, keeps running and solves the tables sent to it over an unix domain socket.
+ * This avoids starting an new process for each table, and keeps the thread pool, the result cache and the function cache warm between requests.
+ *
+ * Each request consists of an header line followed by the table payload (TSV or PLA):
+ *   solve [payload length in bytes] <-i [inputs] | -o [outputs] | -pla | -format [text|json|pla] | -engine [qmc|espresso|bdd|zdd] | -cover [bnb|petrick] | -shared>
+ * The response is an status line followed by the result or the error message:
+ *   ok [result length in bytes]
+ *   error [message length in bytes]
+ * The connection stays open for further requests, the request "stop" shuts the server down.
+ *
+ * Each connection is handled by its own thread, the tables are solved one at an time on the shared thread pool.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <list>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include "server.hpp"
+#include "frameprint.hpp"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <winsock2.h>
+#include <afunix.h>
+typedef SOCKET socket_handle;
+#define close_socket closesocket
+#define SHUT_RDWR SD_BOTH
+#else
+#include <unistd.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+typedef int socket_handle;
+#define INVALID_SOCKET -1
+#define close_socket ::close
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// the payload is buffered completely before it is parsed, larger requests are rejected and their connection closed
+#define SERVER_MAX_PAYLOAD_SIZE (256ULL * 1024 * 1024)
+// the header lines are short, an client sending data without an line break is stopped at this length
+#define SERVER_MAX_HEADER_SIZE 4096
+
+ResultCache::ResultCache(size_t capacity) : capacity(capacity) {}
+
+bool ResultCache::find(const std::string& key, std::string& result)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	auto entry = this->results.find(key);
+	if (entry == this->results.end()) return false;
+	result = entry->second;
+	return true;
+}
+
+void ResultCache::insert(const std::string& key, const std::string& result)
+{
+	size_t entrySize = key.size() + result.size();
+	if (entrySize > this->capacity) return;
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if (!this->results.emplace(key, result).second) return;
+	this->insertionOrder.push_back(key);
+	this->size += entrySize;
+
+	while (this->size > this->capacity)
+	{
+		auto oldest = this->results.find(this->insertionOrder.front());
+		this->size -= oldest->first.size() + oldest->second.size();
+		this->results.erase(oldest);
+		this->insertionOrder.pop_front();
+	}
+}
+
+/**
+ * An connection to an client, reads are buffered since the header lines have to be read byte by byte otherwise.
+ */
+class ServerConnection {
+
+private:
+	socket_handle socket;
+	std::string buffer;
+	size_t bufferPos = 0;
+
+	bool fill()
+	{
+		char chunk[65536];
+		int received = recv(this->socket, chunk, sizeof(chunk), 0);
+		if (received <= 0) return false;
+		this->buffer.erase(0, this->bufferPos);
+		this->bufferPos = 0;
+		this->buffer.append(chunk, received);
+		return true;
+	}
+
+public:
+	ServerConnection(socket_handle socket) : socket(socket) {}
+	~ServerConnection() { close_socket(this->socket); }
+
+	bool readLine(std::string& line)
+	{
+		size_t end;
+		while ((end = this->buffer.find('\n', this->bufferPos)) == std::string::npos && this->buffer.size() - this->bufferPos <= SERVER_MAX_HEADER_SIZE)
+			if (!fill()) return false;
+		if (end == std::string::npos || end - this->bufferPos > SERVER_MAX_HEADER_SIZE)
+		{
+			// the rest of the line is not read, so the connection can not continue with the next request
+			respond(false, "header line exceeds the maximum of " + std::to_string(SERVER_MAX_HEADER_SIZE) + " bytes");
+			return false;
+		}
+		line = this->buffer.substr(this->bufferPos, end - this->bufferPos);
+		if (!line.empty() && line.back() == '\r') line.pop_back();
+		this->bufferPos = end + 1;
+		return true;
+	}
+
+	bool readBytes(size_t length, std::string& data)
+	{
+		while (this->buffer.size() - this->bufferPos < length)
+			if (!fill()) return false;
+		data = this->buffer.substr(this->bufferPos, length);
+		this->bufferPos += length;
+		return true;
+	}
+
+	bool write(const std::string& data)
+	{
+		size_t sent = 0;
+		while (sent < data.size())
+		{
+			int written = send(this->socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+			if (written <= 0) return false;
+			sent += written;
+		}
+		return true;
+	}
+
+	bool respond(bool ok, const std::string& message)
+	{
+		return write((ok ? "ok " : "error ") + std::to_string(message.size()) + "\n" + message);
+	}
+
+};
+
+/**
+ * The state shared by all connections of the server.
+ */
+struct ServerState {
+	SolverOptions options;
+	std::unique_ptr<ThreadPool> pool;
+	std::mutex poolMutex;
+	ResultCache cache;
+	NPNCache functionCache;
+	std::atomic<bool> stopping = false;
+	std::string socketPath;
+	bool logRequests;
+	std::mutex clientsMutex;
+	std::vector<socket_handle> clients;
+
+	ServerState(const SolverOptions& options, size_t cacheCapacity) : options(options), cache(cacheCapacity) {}
+};
+
+bool parse_request(std::istringstream& header, SolverOptions& options, unsigned int& inputs, unsigned int& outputs, bool& pla, std::string& error)
+{
+	std::string flag;
+	while (header >> flag)
+	{
+		std::string val;
+		if (flag == "-pla") {
+			pla = true;
+		} else if (flag == "-shared") {
+			options.sharedTerms = true;
+		} else if (!(header >> val)) {
+			error = "missing value for " + flag;
+			return false;
+		} else if (flag == "-i" || flag == "-o") {
+			unsigned long value = std::strtoul(val.c_str(), nullptr, 10);
+			(flag == "-i" ? inputs : outputs) = value;
+		} else if (flag == "-format" && (val == "text" || val == "json" || val == "pla")) {
+			options.format = val == "json" ? ResultFormat::JSON : val == "pla" ? ResultFormat::PLA : ResultFormat::TEXT;
+		} else if (flag == "-engine" && (val == "qmc" || val == "espresso" || val == "bdd" || val == "zdd")) {
+			options.engine = val == "espresso" ? SolverEngine::ESPRESSO : val == "bdd" ? SolverEngine::BDD : val == "zdd" ? SolverEngine::ZDD : SolverEngine::QMC;
+		} else if (flag == "-cover" && (val == "bnb" || val == "petrick")) {
+			options.coverMethod = val == "petrick" ? QMCCoverMethod::PETRICK : QMCCoverMethod::BRANCH_AND_BOUND;
+		} else {
+			error = "invalid option " + flag + " " + val;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool handle_request(ServerState& state, ServerConnection& connection, std::istringstream& header)
+{
+
+	size_t length = 0;
+	if (!(header >> length))
+		return connection.respond(false, "missing payload length");
+	if (length > SERVER_MAX_PAYLOAD_SIZE)
+	{
+		// the payload is not read, so the connection can not continue with the next request
+		connection.respond(false, "payload exceeds the maximum of " + std::to_string(SERVER_MAX_PAYLOAD_SIZE) + " bytes");
+		return false;
+	}
+
+	SolverOptions options = state.options;
+	unsigned int inputs = 0;
+	unsigned int outputs = 0;
+	bool pla = false;
+	std::string error;
+	bool valid = parse_request(header, options, inputs, outputs, pla, error);
+
+	// the payload has to be read in any case, otherwise the next request would start in the middle of it
+	std::string payload;
+	if (!connection.readBytes(length, payload)) return false;
+	if (!valid) return connection.respond(false, error);
+
+	/**
+	 * the cache key contains everything the result depends on, the payload is compared completely
+	 * so that two different tables never share an result.
+	 */
+	std::string key = std::to_string(inputs) + " " + std::to_string(outputs) + " " + std::to_string(pla) + " " + std::to_string(options.format) + " " +
+			std::to_string(options.engine) + " " + std::to_string(options.coverMethod) + " " + std::to_string(options.sharedTerms) + "\n" + payload;
+	std::string result;
+	if (state.cache.find(key, result))
+	{
+		if (state.logRequests)
+			wprintf(L"[i] request: %zu bytes, cached result\n", length);
+		return connection.respond(true, result);
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::unique_ptr<TruthTable> table = parse_table(payload, pla, inputs, outputs);
+	if (!table)
+		return connection.respond(false, "failed to parse table");
+	if (!check_table(*table, options))
+		return connection.respond(false, "table exceeds the supported size");
+
+	std::vector<std::vector<QMCImplicant>> finalTerms;
+	std::vector<bool> complemented;
+	if (state.pool)
+	{
+		// the pool is shared between the connections, ThreadPool::wait() would also wait for the tasks of other requests
+		std::lock_guard<std::mutex> lock(state.poolMutex);
+		solve_table(*table, options, finalTerms, complemented, nullptr, state.pool.get(), &state.functionCache);
+	}
+	else
+	{
+		solve_table(*table, options, finalTerms, complemented, nullptr, nullptr, &state.functionCache);
+	}
+
+	// the results only contain ASCII characters, so they can be sent as narrow text
+	std::wstring formatted;
+	format_results(finalTerms, complemented, table->inputCount(), options.format, formatted);
+	result.assign(formatted.begin(), formatted.end());
+	state.cache.insert(key, result);
+
+	if (state.logRequests)
+		wprintf(L"[i] request: %zu bytes, %u inputs, %u outputs, solved in %.3f ms\n", length, table->inputCount(), table->outputCount(),
+				std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	return connection.respond(true, result);
+
+}
+
+void stop_server(ServerState& state)
+{
+
+	state.stopping = true;
+
+	// the other connections are waiting for their next request, shutting down their sockets ends the wait
+	{
+		std::lock_guard<std::mutex> lock(state.clientsMutex);
+		for (socket_handle client : state.clients)
+			shutdown(client, SHUT_RDWR);
+	}
+
+	// the accept loop only notices the stop with the next connection, so connect once more
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	state.socketPath.copy(address.sun_path, state.socketPath.size());
+	socket_handle wakeup = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (wakeup == INVALID_SOCKET) return;
+	connect(wakeup, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+	close_socket(wakeup);
+
+}
+
+void handle_connection(ServerState& state, socket_handle socket)
+{
+
+	ServerConnection connection(socket);
+	{
+		std::lock_guard<std::mutex> lock(state.clientsMutex);
+		state.clients.push_back(socket);
+	}
+
+	std::string line;
+	while (!state.stopping && connection.readLine(line))
+	{
+		std::istringstream header(line);
+		std::string command;
+		header >> command;
+
+		if (command == "solve")
+		{
+			if (!handle_request(state, connection, header)) break;
+		}
+		else if (command == "stop")
+		{
+			connection.respond(true, "");
+			stop_server(state);
+			break;
+		}
+		else if (!command.empty())
+		{
+			if (!connection.respond(false, "unknown command " + command)) break;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(state.clientsMutex);
+	state.clients.erase(std::find(state.clients.begin(), state.clients.end(), socket));
+
+}
+
+bool remove_stale_socket(const std::string& socketPath, const sockaddr_un& address)
+{
+
+	// only an socket without an server listening on it is removed, any other file is left alone
+#ifdef _WIN32
+	DWORD attributes = GetFileAttributesA(socketPath.c_str());
+	if (attributes == INVALID_FILE_ATTRIBUTES) return true;
+	bool isSocket = (attributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+#else
+	struct stat info;
+	if (lstat(socketPath.c_str(), &info) != 0) return errno == ENOENT;
+	bool isSocket = S_ISSOCK(info.st_mode);
+#endif
+	if (!isSocket)
+	{
+		wprintf(L"[!] socket path exists and is not an socket: %s\n", socketPath.c_str());
+		return false;
+	}
+
+	socket_handle probe = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (probe == INVALID_SOCKET) return false;
+	bool listening = connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+	close_socket(probe);
+	if (listening)
+	{
+		wprintf(L"[!] an server is already running on socket: %s\n", socketPath.c_str());
+		return false;
+	}
+
+	return std::remove(socketPath.c_str()) == 0;
+
+}
+
+bool run_server(const std::string& socketPath, const SolverOptions& options, size_t cacheCapacity)
+{
+
+	// the connections are only logged, the tables and the progress of the solver are not printed
+	ServerState state(options, cacheCapacity);
+	state.options.quiet = true;
+	state.options.verbose = false;
+	state.options.stats = false;
+	if (state.options.format == ResultFormat::FRAME)
+		state.options.format = ResultFormat::TEXT;
+	state.socketPath = socketPath;
+	state.logRequests = !options.quiet;
+	set_quiet_print(true);
+
+	if (options.jobs != 1)
+		state.pool = std::make_unique<ThreadPool>(options.jobs);
+
+#ifdef _WIN32
+	WSADATA wsaData;
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+	{
+		wprintf(L"[!] failed to initialize winsock!\n");
+		return false;
+	}
+#endif
+
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path))
+	{
+		wprintf(L"[!] socket path too long: %s\n", socketPath.c_str());
+		return false;
+	}
+	socketPath.copy(address.sun_path, socketPath.size());
+
+	// an socket file left over from an previous server would prevent binding
+	socket_handle listener = INVALID_SOCKET;
+	if (!remove_stale_socket(socketPath, address) ||
+			(listener = socket(AF_UNIX, SOCK_STREAM, 0)) == INVALID_SOCKET ||
+			bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+			listen(listener, 16) != 0)
+	{
+		wprintf(L"[!] failed to listen on socket: %s\n", socketPath.c_str());
+		if (listener != INVALID_SOCKET) close_socket(listener);
+		return false;
+	}
+
+	if (!options.quiet)
+		wprintf(L"[i] listening on %s with %u threads\n", socketPath.c_str(), state.pool ? state.pool->threadCount() : 1);
+	fflush(stdout);
+
+	// the threads of closed connections are joined with the next accepted connection, so they do not pile up
+	struct ConnectionThread {
+		std::thread thread;
+		std::atomic<bool> finished = false;
+	};
+	std::list<ConnectionThread> connections;
+	bool acceptFailed = false;
+	while (!state.stopping)
+	{
+		socket_handle client = accept(listener, nullptr, nullptr);
+		if (client == INVALID_SOCKET)
+		{
+			// errors like too many open files persist until an connection is closed, so wait instead of retrying at once
+			if (!acceptFailed && !state.stopping)
+				wprintf(L"[!] failed to accept connection, retrying\n");
+			acceptFailed = true;
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			continue;
+		}
+		acceptFailed = false;
+		if (state.stopping)
+		{
+			close_socket(client);
+			break;
+		}
+
+		for (auto connection = connections.begin(); connection != connections.end(); )
+		{
+			if (!connection->finished)
+			{
+				connection++;
+				continue;
+			}
+			connection->thread.join();
+			connection = connections.erase(connection);
+		}
+
+		ConnectionThread& connection = connections.emplace_back();
+		connection.thread = std::thread([&state, client, &finished = connection.finished]() {
+			handle_connection(state, client);
+			finished = true;
+		});
+	}
+
+	close_socket(listener);
+	std::remove(socketPath.c_str());
+	for (ConnectionThread& connection : connections)
+		connection.thread.join();
+#ifdef _WIN32
+	WSACleanup();
+#endif
+
+	if (!options.quiet)
+		wprintf(L"[i] server stopped\n");
+	return true;
+
+}
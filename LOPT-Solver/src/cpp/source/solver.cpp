@@ -0,0 +1,638 @@
+/*
+ * solver.cpp
+ *
+ * Loading of the truth tables and the solver pipeline for the individual outputs.
+ * Used by the command line (climain.cpp) and the batch mode (batch.cpp).
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <stdio.h>
+#include <algorithm>
+#include <unordered_map>
+#include "solver.hpp"
+#include "tableprint.hpp"
+#include "frameprint.hpp"
+#include "kvm.hpp"
+#include "espresso.hpp"
+#include "bdd.hpp"
+#include "zdd.hpp"
+#include "tableparse.hpp"
+#include "plaformat.hpp"
+#include "mappedfile.hpp"
+
+std::unique_ptr<TruthTable> load_table(const std::string& tableFilePath, unsigned int inputs, unsigned int outputs, const SolverOptions& options)
+{
+
+	info_print(L"[i] loading truth table from file ...\n");
+
+	// try to map the truth table file into memory, it is parsed directly from there
+	MappedFile tableFile;
+	if (!tableFile.open(tableFilePath)) {
+		wprintf(L"[!] failed to open truth table file: %s\n", tableFilePath.c_str());
+		return nullptr;
+	}
+	std::string_view tableStr = tableFile.view();
+
+	if (!options.quiet)
+		wprintf(L"[i] parsing :\n%.*s\n", static_cast<int>(tableStr.size()), tableStr.data());
+
+	return parse_table(tableStr, is_pla_file(tableFilePath), inputs, outputs);
+
+}
+
+std::unique_ptr<TruthTable> parse_table(std::string_view tableStr, bool pla, unsigned int inputs, unsigned int outputs)
+{
+
+	/**
+	 * PLA files define the number of inputs and outputs themselves, and their cubes are used as rows directly
+	 */
+	if (pla)
+	{
+		std::vector<TriStateBool> values;
+		unsigned int plaInputs = 0;
+		unsigned int plaOutputs = 0;
+		TriStateBool undefinedValue = TriStateBool::DONT_CARE;
+		if (!parse_pla(tableStr, values, plaInputs, plaOutputs, undefinedValue))
+			return nullptr;
+
+		info_print(L"[i] checking input output count : inputs = %u outputs = %u ... ", plaInputs, plaOutputs);
+		if ((inputs != 0 && inputs != plaInputs) || (outputs != 0 && outputs != plaOutputs))
+		{
+			wprintf(L"\n[!] number of inputs or outputs does not match the PLA file!\n");
+			return nullptr;
+		}
+		info_print(L"OK\n");
+
+		info_print(L"[i] table loaded successfully\n");
+		return std::make_unique<TruthTable>(std::move(values), plaInputs, plaOutputs, undefinedValue);
+	}
+
+	if (inputs == 0 && outputs == 0) {
+		wprintf(L"[!] number of inputs and/or outputs not defined!\n");
+		return nullptr;
+	}
+
+	// try to parse truth table string
+	std::vector<TriStateBool> values;
+	size_t width = 0;
+	if (!parse_truthtable(tableStr, values, width))
+		return nullptr;
+
+	// validate data
+	info_print(L"[i] checking cell count : width = %zu data = %zu ... ", width, values.size());
+	if (width == 0) {
+		wprintf(L"\n[!] empty table data!\n");
+		return nullptr;
+	} else if (values.size() % width != 0) {
+		wprintf(L"\n[!] table data incomplete!\n");
+		return nullptr;
+	}
+	info_print(L"OK\n");
+
+	info_print(L"[i] checking input output count : width = %zu inputs = %u outputs = %u ... ", width, inputs, outputs);
+	if (inputs == 0)
+		inputs = width - outputs;
+	else if (outputs == 0)
+		outputs = width - inputs;
+	else if (outputs + inputs != width)
+	{
+		wprintf(L"\n[!] number of inputs + outputs does not match table width!\n");
+		return nullptr;
+	}
+	info_print(L"OK\n");
+
+	// fill table with output states, the parsed cells are moved into the table without copying them
+	info_print(L"[i] table loaded successfully\n");
+	return std::make_unique<TruthTable>(std::move(values), inputs, outputs);
+
+}
+
+bool check_table(const TruthTable& table, const SolverOptions& options)
+{
+
+	if (table.inputCount() > QMC_MAX_VARIABLES)
+	{
+		wprintf(L"[!] number of inputs exceeds the supported maximum of %u!\n", QMC_MAX_VARIABLES);
+		return false;
+	}
+
+	// the QMC engine starts from all states of the function, with or without shared terms, only the other engines work on the cubes of the table
+	if (options.engine == SolverEngine::QMC && table.inputCount() > TRUTHTABLE_MAX_ENUMERATED_INPUTS)
+	{
+		wprintf(L"[!] number of inputs exceeds the maximum of %u for the QMC engine, use -engine espresso, bdd or zdd!\n", TRUTHTABLE_MAX_ENUMERATED_INPUTS);
+		return false;
+	}
+
+	if (options.sharedTerms && table.outputCount() > QMC_MAX_OUTPUTS)
+	{
+		wprintf(L"[!] number of outputs exceeds the supported maximum of %u for shared terms!\n", QMC_MAX_OUTPUTS);
+		return false;
+	}
+
+	if (options.sharedTerms && options.engine != SolverEngine::QMC)
+	{
+		wprintf(L"[!] shared terms are only supported by the QMC engine!\n");
+		return false;
+	}
+
+	return true;
+
+}
+
+void find_output_aliases(const TruthTable& table, std::vector<OutputAlias>& aliases)
+{
+
+	/**
+	 * the outputs are grouped by the fingerprint of their cells, the first output with an fingerprint solves the function.
+	 * an later output with the same fingerprint, or the fingerprint of the complement, is compared cell by cell to rule out collisions.
+	 */
+	aliases.assign(table.outputCount(), {});
+	std::unordered_multimap<uint64_t, unsigned int> solved;
+	for (unsigned int o = 0; o < table.outputCount(); o++)
+	{
+		for (bool complement : { false, true })
+		{
+			auto range = solved.equal_range(table.outputFingerprint(o, complement));
+			for (auto entry = range.first; entry != range.second; entry++)
+			{
+				if (!table.outputMatches(o, entry->second, complement)) continue;
+				aliases[o] = { static_cast<int>(entry->second), complement };
+				break;
+			}
+			if (aliases[o].source >= 0) break;
+		}
+		if (aliases[o].source < 0)
+			solved.emplace(table.outputFingerprint(o, false), o);
+	}
+
+}
+
+void solve_output_bdd(const TruthTable& table, unsigned int o, const SolverOptions& options, std::vector<QMCImplicant>& finalTerm, PhaseTimer& timer, OutputStats* stats)
+{
+
+	info_print(L"[i] output %u: building BDD of output function ...\n", o);
+	timer.restart();
+	BDDFunction function(table.inputCount());
+	function.initialize(table, o);
+	timer.finish(SolverPhase::PHASE_INITIALIZE);
+
+	std::vector<QMCImplicant> primes;
+	std::vector<QMCImplicant> essentialPrimes;
+	if (options.engine == SolverEngine::ZDD)
+	{
+		/**
+		 * the primes are kept as ZDD, and the essential primes are extracted from it without enumerating the primes.
+		 * only the primes of the remaining cyclic core are enumerated for the chart.
+		 */
+		info_print(L"[i] output %u: computing prime implicants as ZDD ...\n", o);
+		ImplicitPrimeChart implicitChart(function.diagram());
+		implicitChart.initialize(function.onSetFunction(), function.dcSetFunction());
+		timer.finish(SolverPhase::PHASE_PRIMES);
+		double primeCount = implicitChart.primeCount();
+		info_print(L"[i] output %u: prime implicants: %.0f\n", o, primeCount);
+
+		implicitChart.reduce(essentialPrimes);
+		std::vector<QMCCube> corePrimes;
+		implicitChart.primeImplicants(corePrimes);
+		function.restrictToCore(implicitChart.mintermSet(), corePrimes, primes);
+		timer.finish(SolverPhase::PHASE_REDUCE);
+		info_print(L"[i] output %u: essential primes: %zu, primes in cyclic core: %zu\n", o, essentialPrimes.size(), primes.size());
+		if (stats != nullptr)
+		{
+			stats->implicitPrimes = primeCount;
+			stats->zddNodes = implicitChart.nodeCount();
+		}
+	}
+	else
+	{
+		info_print(L"[i] output %u: computing prime implicants from BDD ...\n", o);
+		function.primeImplicants(primes);
+		timer.finish(SolverPhase::PHASE_PRIMES);
+		info_print(L"[i] output %u: prime implicants: %zu\n", o, primes.size());
+	}
+
+	/**
+	 * the chart starts with one minterm of each prime, instead of all minterms of the function.
+	 * after each cover of the chart, the BDD is checked for minterms not covered by it, which are added to the chart.
+	 * an cover which is optimal for some of the minterms and covers all of them is also optimal for all of them.
+	 */
+	std::vector<QMCMinterm> minterms;
+	function.sampleMinterms(primes, minterms);
+	timer.finish(SolverPhase::PHASE_CHART);
+	unsigned int rounds = 0;
+	do
+	{
+		rounds++;
+		QMCPrimeChart chart;
+		chart.initialize(primes, minterms);
+		timer.finish(SolverPhase::PHASE_CHART);
+		if (stats != nullptr)
+		{
+			stats->chartPrimes = chart.primeImplicants().size();
+			stats->chartMinterms = chart.mintermSet().size();
+		}
+
+		finalTerm = essentialPrimes;
+		chart.reduce(finalTerm);
+		timer.finish(SolverPhase::PHASE_REDUCE);
+		if (stats != nullptr)
+		{
+			stats->essentialPrimes = finalTerm.size();
+			stats->corePrimes = chart.primeImplicants().size();
+			stats->coreMinterms = chart.mintermSet().size();
+		}
+
+		if (chart.mintermSet().size() != 0)
+			chart.findOptimalPrimes(finalTerm, options.coverMethod, stats != nullptr ? &stats->coverCounters : nullptr);
+		timer.finish(SolverPhase::PHASE_SELECT);
+	}
+	while (function.uncoveredMinterms(finalTerm, minterms));
+	info_print(L"[i] output %u: cover completed after %u rounds, minterms in chart: %zu\n", o, rounds, minterms.size());
+
+	if (stats != nullptr)
+	{
+		stats->bddNodes = function.nodeCount();
+		stats->terms = finalTerm.size();
+	}
+
+}
+
+void solve_output(const TruthTable& table, unsigned int o, const SolverOptions& options, std::vector<QMCImplicant>& finalTerm, ThreadPool* mergePool, OutputStats* stats, NPNCache* cache)
+{
+
+	bool verbose = options.verbose;
+	PhaseTimer timer(stats);
+
+	info_print(L"[i] solve for output %u (%u/%u) ...\n", o, o+1, table.outputCount());
+
+	/**
+	 * the KV-map is only used to give a visual representation of the function currently being processed
+	 * so it is only generated in verbose mode, and not for the BDD engine which is used for functions too large to enumerate
+	 */
+	if (verbose && options.engine != SolverEngine::BDD && options.engine != SolverEngine::ZDD && table.inputCount() <= TRUTHTABLE_MAX_ENUMERATED_INPUTS)
+	{
+		KVMap kvMap(table, o);
+		auto lock = print_lock();
+		info_print(L"[i] output %u: generate KV map ...\n", o);
+		print_kvmap(kvMap);
+	}
+
+	/**
+	 * the espresso engine works directly on the cubes of the truth table, instead of enumerating all minterms.
+	 * it finds an near minimal function much faster on large tables, but the result is not guaranteed to be optimal.
+	 */
+	if (options.engine == SolverEngine::ESPRESSO)
+	{
+		info_print(L"[i] output %u: minimizing with espresso heuristic ...\n", o);
+		timer.restart();
+		EspressoCover cover;
+		cover.initialize(table, o);
+		timer.finish(SolverPhase::PHASE_INITIALIZE);
+		cover.minimize();
+
+		finalTerm.clear();
+		cover.implicants(finalTerm);
+		timer.finish(SolverPhase::PHASE_SELECT);
+		if (stats != nullptr)
+			stats->terms = finalTerm.size();
+		if (!options.quiet)
+		{
+			auto lock = print_lock();
+			wprintf(L"[i] output %u: -> final term: ", o);
+			print_bool_term(finalTerm);
+			wprintf(L"\n");
+		}
+		return;
+	}
+
+	/**
+	 * the BDD engine never enumerates the minterms of the function, so it can solve functions with many inputs
+	 * as long as their BDD and their number of primes stay small, or with the ZDD engine the cyclic core of their primes.
+	 */
+	if (options.engine == SolverEngine::BDD || options.engine == SolverEngine::ZDD)
+	{
+		solve_output_bdd(table, o, options, finalTerm, timer, stats);
+		if (!options.quiet)
+		{
+			auto lock = print_lock();
+			wprintf(L"[i] output %u: -> final term: ", o);
+			print_bool_term(finalTerm);
+			wprintf(L"\n");
+		}
+		return;
+	}
+
+	/**
+	 * small functions are looked up in the cache first, by their canonical form.
+	 * an function already solved for an other output (or table) only has to be transformed back to the inputs of this output.
+	 */
+	NPNKey cacheKey;
+	NPNTransform cacheTransform;
+	if (cache != nullptr && NPNCache::supports(table.inputCount()))
+	{
+		BitSet onSet, dcSet;
+		table.outputSets(o, onSet, dcSet);
+		uint64_t onWord = 0;
+		uint64_t dcWord = 0;
+		for (unsigned int id = onSet.next(0); id < onSet.size(); id = onSet.next(id + 1))
+			onWord |= 1ULL << id;
+		for (unsigned int id = dcSet.next(0); id < dcSet.size(); id = dcSet.next(id + 1))
+			dcWord |= 1ULL << id;
+
+		cacheKey = NPNCache::canonicalize(table.inputCount(), onWord, dcWord, cacheTransform);
+		if (cache->find(cacheKey, cacheTransform, finalTerm))
+		{
+			info_print(L"[i] output %u: function found in cache, transformed to inputs of output\n", o);
+			if (stats != nullptr)
+			{
+				stats->cacheHit = true;
+				stats->terms = finalTerm.size();
+			}
+			if (!options.quiet)
+			{
+				auto lock = print_lock();
+				wprintf(L"[i] output %u: -> final term: ", o);
+				print_bool_term(finalTerm);
+				wprintf(L"\n");
+			}
+			return;
+		}
+	}
+
+	/**
+	 * next the QMC (Quine–McCluskey) algorithm is applied.
+	 * here we initialize the initial minterms in the QMC-stack with the states
+	 * of the truth table which evaluate either to TRUE or DONT_CARE.
+	 * the gaps in the truth table (omitted states) are filled in as DONT_CARE.
+	 */
+	info_print(L"[i] output %u: initialize QMC implicant chart ...\n", o);
+	timer.restart();
+	QMCStack implicantStack;
+	implicantStack.initialize(table, o);
+	timer.finish(SolverPhase::PHASE_INITIALIZE);
+
+	/**
+	 * next the QMC algorithm is applied to find the prime implicants.
+	 * these can not be combined any further and are highlighted in the printed table.
+	 */
+	info_print(L"[i] output %u: searching for prime implicants ...\n", o);
+	timer.restart();
+	while (implicantStack.tryMerge(mergePool));
+	timer.finish(SolverPhase::PHASE_PRIMES);
+	if (verbose)
+	{
+		auto lock = print_lock();
+		print_qmcstack(implicantStack);
+	}
+
+	/**
+	 * here we extract all prime implicants from the stack and put them
+	 * into an QMC prime implicant chart.
+	 */
+	info_print(L"[i] output %u: initializing prime implicant chart ...\n", o);
+	timer.restart();
+	QMCPrimeChart chart;
+	chart.initialize(implicantStack);
+	timer.finish(SolverPhase::PHASE_CHART);
+	if (verbose)
+	{
+		auto lock = print_lock();
+		print_qmcchart(chart);
+	}
+	if (stats != nullptr)
+	{
+		collect_stack_stats(implicantStack, *stats);
+		stats->chartPrimes = chart.primeImplicants().size();
+		stats->chartMinterms = chart.mintermSet().size();
+	}
+
+	/**
+	 * identifying the essential prime implicant terms in the chart and
+	 * remove them and store them in an list.
+	 * primes and minterms which are dominated by others are removed as well,
+	 * repeated until only the cyclic core of the chart remains.
+	 */
+	timer.restart();
+	std::vector<QMCImplicant> essentialPrimeImplicants;
+	chart.reduce(essentialPrimeImplicants);
+	timer.finish(SolverPhase::PHASE_REDUCE);
+	if (stats != nullptr)
+	{
+		stats->essentialPrimes = essentialPrimeImplicants.size();
+		stats->corePrimes = chart.primeImplicants().size();
+		stats->coreMinterms = chart.mintermSet().size();
+	}
+	{
+		auto lock = print_lock();
+		info_print(L"[i] output %u: calculating optimal prime implicants for minimal logical function ...\n", o);
+		info_print(L"[i] output %u: identifying essential prime implicants ... EPIs: %u\n", o, essentialPrimeImplicants.size());
+		info_print(L"[i] output %u: reduced chart to cyclic core ... primes: %u minterms: %u\n", o, chart.primeImplicants().size(), chart.mintermSet().size());
+	}
+
+	/**
+	 * if non essential primes are remaining, find the optimal combination of them
+	 * which covers all remaining minterms with the least number of terms.
+	 */
+	if (chart.mintermSet().size() != 0)
+	{
+		{
+			auto lock = print_lock();
+			info_print(L"[i] output %u: non essential prime implicants remaining, continue ...\n", o);
+			if (verbose) print_qmcchart(chart);
+		}
+		timer.restart();
+		chart.findOptimalPrimes(essentialPrimeImplicants, options.coverMethod, stats != nullptr ? &stats->coverCounters : nullptr);
+		timer.finish(SolverPhase::PHASE_SELECT);
+	}
+
+	finalTerm = essentialPrimeImplicants;
+	if (cache != nullptr && NPNCache::supports(table.inputCount()))
+		cache->insert(cacheKey, cacheTransform, finalTerm);
+	if (stats != nullptr)
+		stats->terms = finalTerm.size();
+	if (!options.quiet)
+	{
+		auto lock = print_lock();
+		wprintf(L"[i] output %u: -> final term: ", o);
+		print_bool_term(essentialPrimeImplicants);
+		wprintf(L"\n");
+	}
+
+}
+
+void solve_shared(const TruthTable& table, const SolverOptions& options, std::vector<std::vector<QMCImplicant>>& finalTerms, ThreadPool* mergePool, OutputStats* stats)
+{
+
+	bool verbose = options.verbose;
+	PhaseTimer timer(stats);
+
+	/**
+	 * all outputs are solved together, each implicant is tagged with the outputs it is an implicant of.
+	 * this way an product term required by multiple outputs is only searched and selected once.
+	 */
+	info_print(L"[i] solve all %u outputs with shared terms ...\n", table.outputCount());
+	info_print(L"[i] initialize QMC implicant chart ...\n");
+	timer.restart();
+	QMCStack implicantStack;
+	implicantStack.initialize(table);
+	timer.finish(SolverPhase::PHASE_INITIALIZE);
+
+	info_print(L"[i] searching for prime implicants ...\n");
+	timer.restart();
+	while (implicantStack.tryMerge(mergePool));
+	timer.finish(SolverPhase::PHASE_PRIMES);
+	if (verbose) print_qmcstack(implicantStack);
+
+	/**
+	 * the chart contains one column for each TRUE state of each output,
+	 * an prime covers the columns of all outputs it is tagged with.
+	 */
+	info_print(L"[i] initializing prime implicant chart ...\n");
+	timer.restart();
+	QMCPrimeChart chart;
+	chart.initialize(implicantStack);
+	timer.finish(SolverPhase::PHASE_CHART);
+	if (verbose) print_qmcchart(chart);
+	if (stats != nullptr)
+	{
+		collect_stack_stats(implicantStack, *stats);
+		stats->chartPrimes = chart.primeImplicants().size();
+		stats->chartMinterms = chart.mintermSet().size();
+	}
+
+	timer.restart();
+	std::vector<QMCImplicant> selectedPrimes;
+	chart.reduce(selectedPrimes);
+	timer.finish(SolverPhase::PHASE_REDUCE);
+	if (stats != nullptr)
+	{
+		stats->essentialPrimes = selectedPrimes.size();
+		stats->corePrimes = chart.primeImplicants().size();
+		stats->coreMinterms = chart.mintermSet().size();
+	}
+	info_print(L"[i] calculating optimal prime implicants for minimal logical functions ...\n");
+	info_print(L"[i] identifying essential prime implicants ... EPIs: %u\n", selectedPrimes.size());
+	info_print(L"[i] reduced chart to cyclic core ... primes: %u minterms: %u\n", chart.primeImplicants().size(), chart.mintermSet().size());
+
+	if (chart.mintermSet().size() != 0)
+	{
+		info_print(L"[i] non essential prime implicants remaining, continue ...\n");
+		if (verbose) print_qmcchart(chart);
+		timer.restart();
+		chart.findOptimalPrimes(selectedPrimes, options.coverMethod, stats != nullptr ? &stats->coverCounters : nullptr);
+		timer.finish(SolverPhase::PHASE_SELECT);
+	}
+	info_print(L"[i] selected %u shared terms\n", selectedPrimes.size());
+	if (stats != nullptr)
+		stats->terms = selectedPrimes.size();
+
+	/**
+	 * finally each output gets the selected terms it is tagged with, except the ones it does not need.
+	 */
+	for (unsigned int o = 0; o < table.outputCount(); o++)
+	{
+		QMCPrimeChart::selectOutputTerm(selectedPrimes, implicantStack.mintermSet(), o, finalTerms[o]);
+		if (options.quiet) continue;
+		wprintf(L"[i] output %u: -> final term: ", o);
+		print_bool_term(finalTerms[o]);
+		wprintf(L"\n");
+	}
+
+}
+
+void solve_table(const TruthTable& table, const SolverOptions& options, std::vector<std::vector<QMCImplicant>>& finalTerms, std::vector<bool>& complemented, std::vector<OutputStats>* stats, ThreadPool* pool, NPNCache* cache)
+{
+
+	/**
+	 * without an pool from the caller (the server keeps its pool running between requests), an pool is created for this table only.
+	 * when the outputs are solved in parallel, more threads than outputs would only stay idle.
+	 */
+	if (pool == nullptr && options.jobs != 1)
+	{
+		unsigned int threads = options.jobs == 0 ? ThreadPool::defaultThreadCount() : options.jobs;
+		if (!options.sharedTerms && table.outputCount() > 1)
+			threads = std::min(threads, table.outputCount());
+		ThreadPool tablePool(threads);
+		solve_table(table, options, finalTerms, complemented, stats, &tablePool, cache);
+		return;
+	}
+
+	finalTerms.assign(table.outputCount(), {});
+	complemented.assign(table.outputCount(), false);
+
+	/**
+	 * outputs with the same function as an earlier output only copy its terms.
+	 * for an complementary output the terms of the other output describe its OFF-set, so it is reported as their complement.
+	 * with shared terms the identical outputs are covered by the same terms anyway, so this is only done for the separate outputs.
+	 */
+	std::vector<OutputAlias> aliases;
+	if (options.sharedTerms)
+		aliases.assign(table.outputCount(), {});
+	else
+		find_output_aliases(table, aliases);
+
+	// each output gets its own statistics, except for shared terms where all outputs are solved at once
+	if (stats != nullptr)
+	{
+		stats->assign(options.sharedTerms ? 1 : table.outputCount(), {});
+		for (unsigned int o = 0; o < stats->size(); o++)
+			(*stats)[o].output = options.sharedTerms ? -1 : o;
+	}
+	auto statsFor = [stats](unsigned int o) {
+		return stats != nullptr ? &(*stats)[o] : nullptr;
+	};
+
+	/**
+	 * the outputs are completely independent of each other, so they can be solved in parallel.
+	 * each task writes only into its own slot of the final terms, so they stay in output order.
+	 * if there is only one output, the threads are used to merge the implicant groups in parallel instead.
+	 * the same applies when all outputs are solved together with shared terms.
+	 */
+	if (options.sharedTerms)
+	{
+		if (pool != nullptr)
+			info_print(L"[i] merging implicants on %u threads ...\n", pool->threadCount());
+		solve_shared(table, options, finalTerms, pool, statsFor(0));
+	}
+	else if (pool == nullptr)
+	{
+		for (unsigned int o = 0; o < table.outputCount(); o++)
+			if (aliases[o].source < 0)
+				solve_output(table, o, options, finalTerms[o], nullptr, statsFor(o), cache);
+	}
+	else if (table.outputCount() - std::count_if(aliases.begin(), aliases.end(), [](const OutputAlias& a) { return a.source >= 0; }) < 2)
+	{
+		info_print(L"[i] merging implicants on %u threads ...\n", pool->threadCount());
+		for (unsigned int o = 0; o < table.outputCount(); o++)
+			if (aliases[o].source < 0)
+				solve_output(table, o, options, finalTerms[o], pool, statsFor(o), cache);
+	}
+	else
+	{
+		info_print(L"[i] solving outputs on %u threads ...\n", pool->threadCount());
+		for (unsigned int o = 0; o < table.outputCount(); o++)
+			if (aliases[o].source < 0)
+				pool->submit([&table, o, &options, &finalTerms, &statsFor, cache]() {
+					solve_output(table, o, options, finalTerms[o], nullptr, statsFor(o), cache);
+				});
+		pool->wait();
+	}
+
+	// the sources are always earlier outputs which are solved themselves, so they are completed at this point
+	for (unsigned int o = 0; o < table.outputCount(); o++)
+	{
+		if (aliases[o].source < 0) continue;
+		finalTerms[o] = finalTerms[aliases[o].source];
+		complemented[o] = aliases[o].complement;
+		if (stats != nullptr)
+		{
+			(*stats)[o].source = aliases[o].source;
+			(*stats)[o].complement = aliases[o].complement;
+			(*stats)[o].terms = finalTerms[o].size();
+		}
+		info_print(aliases[o].complement ? L"[i] output %u: complement of output %u, reusing its terms\n" : L"[i] output %u: same function as output %u, reusing its terms\n", o, aliases[o].source);
+	}
+
+}
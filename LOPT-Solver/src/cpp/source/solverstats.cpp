@@ -0,0 +1,120 @@
+/*
+ * solverstats.cpp
+ *
+ * Statistics of the solver, collected when enabled with the -stats flag.
+ * The statistics are printed as JSON after the final terms, so they can be tracked over multiple runs.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <stdio.h>
+#include "solverstats.hpp"
+
+// the OS headers are included last, windows.h defines macros which collide with the names used in the other headers
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+const char* SOLVER_PHASE_NAMES[PHASE_COUNT] = { "initialize", "primes", "chart", "reduce", "select" };
+
+PhaseTimer::PhaseTimer(OutputStats* stats)
+{
+	this->stats = stats;
+	this->start = std::chrono::steady_clock::now();
+}
+
+void PhaseTimer::restart()
+{
+	this->start = std::chrono::steady_clock::now();
+}
+
+void PhaseTimer::finish(SolverPhase phase)
+{
+	// the timer restarts right away, so consecutive phases can be timed with the same timer
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (this->stats != nullptr)
+		this->stats->phaseTimes[phase] += std::chrono::duration<double, std::milli>(now - this->start).count();
+	this->start = now;
+}
+
+void collect_stack_stats(const QMCStack& stack, OutputStats& stats)
+{
+	stats.groupSizes.clear();
+	for (unsigned int stage = 0; stage < stack.stageCount(); stage++)
+	{
+		stats.groupSizes.emplace_back();
+		for (unsigned int numberOfOnes = 0; numberOfOnes <= stack.variableCount(); numberOfOnes++)
+		{
+			QMCImplicantSetOpt implicants = stack.implicantSetFor(stage, numberOfOnes);
+			stats.groupSizes.back().push_back(implicants.has_value() ? implicants->get().size() : 0);
+		}
+	}
+	stats.stackCounters = stack.workCounters();
+}
+
+uint64_t peak_memory_usage()
+{
+	// returns the peak resident set size of the process in bytes, or zero if not available
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+	return counters.PeakWorkingSetSize;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+	return usage.ru_maxrss;
+#else
+	return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+void print_solver_stats(const std::vector<OutputStats>& stats, double totalTime)
+{
+	wprintf(L"{\n  \"outputs\": [");
+	for (unsigned int i = 0; i < stats.size(); i++)
+	{
+		const OutputStats& s = stats[i];
+		unsigned int implicants = 0;
+		wprintf(L"%s\n    {\n", i > 0 ? "," : "");
+		wprintf(L"      \"output\": %d,\n", s.output);
+		wprintf(L"      \"stages\": [");
+		for (unsigned int stage = 0; stage < s.groupSizes.size(); stage++)
+		{
+			wprintf(L"%s[", stage > 0 ? ", " : "");
+			for (unsigned int group = 0; group < s.groupSizes[stage].size(); group++)
+			{
+				wprintf(L"%s%u", group > 0 ? ", " : "", s.groupSizes[stage][group]);
+				implicants += s.groupSizes[stage][group];
+			}
+			wprintf(L"]");
+		}
+		wprintf(L"],\n");
+		wprintf(L"      \"implicants\": %u,\n", implicants);
+		wprintf(L"      \"merge_attempts\": %llu,\n      \"merges\": %llu,\n      \"duplicates\": %llu,\n",
+				s.stackCounters.mergeAttempts, s.stackCounters.merges, s.stackCounters.duplicates);
+		wprintf(L"      \"bdd_nodes\": %u,\n", s.bddNodes);
+		wprintf(L"      \"zdd_nodes\": %u, \"implicit_primes\": %.0f,\n", s.zddNodes, s.implicitPrimes);
+		wprintf(L"      \"chart\": { \"primes\": %u, \"minterms\": %u },\n", s.chartPrimes, s.chartMinterms);
+		wprintf(L"      \"essential_primes\": %u,\n", s.essentialPrimes);
+		wprintf(L"      \"core\": { \"primes\": %u, \"minterms\": %u },\n", s.corePrimes, s.coreMinterms);
+		wprintf(L"      \"cover\": { \"search_nodes\": %llu, \"petrick_sums\": %llu, \"petrick_products\": %llu, \"petrick_peak_products\": %llu },\n",
+				s.coverCounters.searchNodes, s.coverCounters.petrickSums, s.coverCounters.petrickProducts, s.coverCounters.petrickPeakProducts);
+		wprintf(L"      \"terms\": %u,\n", s.terms);
+		wprintf(L"      \"reused_from\": %d, \"complement\": %s,\n", s.source, s.complement ? "true" : "false");
+		wprintf(L"      \"cache_hit\": %s,\n", s.cacheHit ? "true" : "false");
+		wprintf(L"      \"time_ms\": { ");
+		for (unsigned int p = 0; p < PHASE_COUNT; p++)
+			wprintf(L"%s\"%s\": %.3f", p > 0 ? ", " : "", SOLVER_PHASE_NAMES[p], s.phaseTimes[p]);
+		wprintf(L" }\n    }");
+	}
+	wprintf(L"\n  ],\n");
+	wprintf(L"  \"peak_rss_kb\": %llu,\n", peak_memory_usage() / 1024);
+	wprintf(L"  \"total_ms\": %.3f\n}\n", totalTime);
+}
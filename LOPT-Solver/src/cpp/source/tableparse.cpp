@@ -0,0 +1,85 @@
+/*
+ * tableparse.cpp
+ *
+ * Parses the truth table text format, one row per line with the cells separated by tabs.
+ * Cells containing TRUE or 1 are TRUE, cells containing FALSE or 0 are FALSE, everything else is DONT_CARE.
+ *
+ * The text is parsed in an single pass without copying any part of it, so it can be an memory mapped file.
+ * Empty lines (and an missing line feed after the last row) are ignored, CR-LF line endings are accepted.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include <stdio.h>
+#include "tableparse.hpp"
+
+TriStateBool parse_cell(std::string_view cell)
+{
+	// TRUE has priority over FALSE, so it is only known to be FALSE after the whole cell was scanned
+	bool isFalse = false;
+	for (size_t i = 0; i < cell.size(); i++)
+	{
+		switch (cell[i])
+		{
+		case '1': return TriStateBool::TRUE;
+		case '0': isFalse = true; break;
+		case 'T': if (cell.substr(i).starts_with("TRUE")) return TriStateBool::TRUE; break;
+		case 't': if (cell.substr(i).starts_with("true")) return TriStateBool::TRUE; break;
+		case 'F': if (cell.substr(i).starts_with("FALSE")) isFalse = true; break;
+		case 'f': if (cell.substr(i).starts_with("false")) isFalse = true; break;
+		}
+	}
+	return isFalse ? TriStateBool::FALSE : TriStateBool::DONT_CARE;
+}
+
+bool parse_truthtable(std::string_view tableStr, std::vector<TriStateBool>& values, size_t& width)
+{
+	width = 0;
+	size_t row = 0;
+	size_t line = 0;
+	size_t pos = 0;
+	while (pos < tableStr.size())
+	{
+
+		size_t lineEnd = tableStr.find('\n', pos);
+		if (lineEnd == std::string_view::npos) lineEnd = tableStr.size();
+		std::string_view rowStr = tableStr.substr(pos, lineEnd - pos);
+		if (!rowStr.empty() && rowStr.back() == '\r') rowStr.remove_suffix(1);
+		pos = lineEnd + 1;
+		line++;
+		if (rowStr.empty()) continue;
+
+		size_t columns = 0;
+		size_t cellBegin = 0;
+		while (true)
+		{
+			size_t cellEnd = rowStr.find('\t', cellBegin);
+			if (cellEnd == std::string_view::npos) cellEnd = rowStr.size();
+			columns++;
+			if (width > 0 && columns > width)
+			{
+				wprintf(L"[!] truth table row %zu (line %zu) has more than %zu columns, extra cell at column %zu!\n", row + 1, line, width, cellBegin + 1);
+				return false;
+			}
+			values.push_back(parse_cell(rowStr.substr(cellBegin, cellEnd - cellBegin)));
+			if (cellEnd == rowStr.size()) break;
+			cellBegin = cellEnd + 1;
+		}
+
+		if (width == 0)
+		{
+			// the first row defines the width of the table, reserve the space for the remaining rows estimated from its length
+			width = columns;
+			values.reserve(tableStr.size() / (rowStr.size() + 1) * width + width);
+		}
+		else if (columns != width)
+		{
+			wprintf(L"[!] truth table row %zu (line %zu) has %zu columns, expected %zu!\n", row + 1, line, columns, width);
+			return false;
+		}
+		row++;
+
+	}
+	return true;
+}
@@ -59,6 +59,7 @@ void print_truthtable(const TruthTable& table)
 				color_print_f(120, 0, 0);
 				wprintf(L" 0 ");
 				break;
+			case UNDEFINED:
 			case DONT_CARE:
 				color_print_b(128, 128, 128);
 				color_print_f(80, 80, 80);
@@ -88,6 +89,10 @@ void print_truthtable(const TruthTable& table)
 				color_print_f(80, 80, 80);
 				wprintf(L" X ");
 				break;
+			case UNDEFINED:
+				reset_print();
+				wprintf(L" ~ ");
+				break;
 			}
 		}
 
@@ -167,6 +172,7 @@ void print_kvmap(const KVMap& map)
 				color_print_f(120, 0, 0);
 				wprintf(L" 0 ");
 				break;
+			case UNDEFINED:
 			case DONT_CARE:
 				color_print_b(128, 128, 128);
 				color_print_f(80, 80, 80);
@@ -216,7 +222,7 @@ void print_qmcstack(const QMCStack& stack)
 	wprintf(L"\n");
 
 	// print stack table
-	for (unsigned int numberOfOnes = 0; numberOfOnes < variables; numberOfOnes++)
+	for (unsigned int numberOfOnes = 0; numberOfOnes <= variables; numberOfOnes++)
 		for (unsigned int implicantIndx = 0; implicantIndx < stack.groupImplicantCount(numberOfOnes); implicantIndx++)
 		{
 
@@ -245,8 +251,8 @@ void print_qmcstack(const QMCStack& stack)
 					noMoreEntries = false;
 
 					// print implicant variables
-					for (auto varstate = implicant.variableStates().begin(); varstate != implicant.variableStates().end(); varstate++)
-						switch(*varstate)
+					for (unsigned int input = 0; input < implicant.variableCount(); input++)
+						switch(implicant.variableState(input))
 						{
 						case TRUE:
 							if (!isPrime) {
@@ -268,6 +274,7 @@ void print_qmcstack(const QMCStack& stack)
 							}
 							wprintf(L"0");
 							break;
+						case UNDEFINED:
 						case DONT_CARE:
 							if (!isPrime) {
 								color_print_b(80, 80, 80);
@@ -300,7 +307,7 @@ void print_qmcchart(const QMCPrimeChart& chart)
 {
 
 	unsigned int primes = chart.primeImplicants().size();
-	unsigned int minterms = chart.mintermIds().size();
+	unsigned int minterms = chart.mintermSet().size();
 	unsigned int variables = chart.variableCount();
 	unsigned int width = std::max(minterms * 5 + variables + 2, 55U);
 
@@ -315,9 +322,9 @@ void print_qmcchart(const QMCPrimeChart& chart)
 	// print chart column labels
 	print_frame_side(width);
 	pos_print(1, 2);
-	for (auto mintermId = chart.mintermIds().begin(); mintermId != chart.mintermIds().end(); mintermId++)
+	for (auto minterm = chart.mintermSet().begin(); minterm != chart.mintermSet().end(); minterm++)
 	{
-		wprintf(L"m%03u|", *mintermId);
+		wprintf(L"m%03u|", minterm->id);
 	}
 	color_print_f(255, 0, 0);
 	for (unsigned int v = 0; v < variables; v++) {
@@ -326,17 +333,19 @@ void print_qmcchart(const QMCPrimeChart& chart)
 	reset_print();
 	wprintf(L"\n");
 
-	for (auto implicant = chart.primeImplicants().begin(); implicant != chart.primeImplicants().end(); implicant++)
+	for (unsigned int prime = 0; prime < primes; prime++)
 	{
 
+		const QMCImplicant* implicant = &chart.primeImplicants().at(prime);
+
 		print_frame_side(width);
 		pos_print(1, 2);
 
 		// print minterm checkmarks
-		for (auto mintermId = chart.mintermIds().begin(); mintermId != chart.mintermIds().end(); mintermId++)
+		for (unsigned int minterm = 0; minterm < minterms; minterm++)
 		{
 
-			bool coversTerm = std::find(implicant->mintermSet().begin(), implicant->mintermSet().end(), *mintermId) != implicant->mintermSet().end();
+			bool coversTerm = chart.covers(prime, minterm);
 
 			if (coversTerm) {
 				color_print_f(0, 255, 0);
@@ -350,8 +359,8 @@ void print_qmcchart(const QMCPrimeChart& chart)
 		}
 
 		// print implicant variable states
-		for (auto varstate = implicant->variableStates().begin(); varstate != implicant->variableStates().end(); varstate++)
-			switch(*varstate)
+		for (unsigned int input = 0; input < implicant->variableCount(); input++)
+			switch(implicant->variableState(input))
 			{
 			case TRUE:
 				color_print_f(0, 120, 0);
@@ -361,6 +370,7 @@ void print_qmcchart(const QMCPrimeChart& chart)
 				color_print_f(120, 0, 0);
 				wprintf(L"0");
 				break;
+			case UNDEFINED:
 			case DONT_CARE:
 				color_print_f(80, 80, 80);
 				wprintf(L"x");
@@ -391,7 +401,7 @@ void print_bool_term(const std::vector<QMCImplicant>& term)
 		for (unsigned int input = 0; input < implicant.variableCount(); input++)
 		{
 
-			TriStateBool state = implicant.variableStates().at(input);
+			TriStateBool state = implicant.variableState(input);
 			if (state != TriStateBool::DONT_CARE)
 			{
 
@@ -415,7 +425,7 @@ void print_bool_term(const std::vector<QMCImplicant>& term)
 
 }
 
-void print_result_table(const std::vector<std::vector<QMCImplicant>>& finalTerms)
+void print_result_table(const std::vector<std::vector<QMCImplicant>>& finalTerms, const std::vector<bool>& complemented)
 {
 
 	unsigned int maxTermLen = 0;
@@ -451,8 +461,9 @@ void print_result_table(const std::vector<std::vector<QMCImplicant>>& finalTerms
 		wprintf(L"%02u", output);
 		reset_print();
 		wprintf(L" = ");
+		if (complemented[output]) wprintf(L"(");
 		print_bool_term(finalTerms.at(output));
-		wprintf(L"\n");
+		wprintf(complemented[output] ? L")'\n" : L"\n");
 
 	}
 
@@ -0,0 +1,95 @@
+/*
+ * threadpool.cpp
+ *
+ * An simple pool of worker threads which process submitted tasks in submission order.
+ *
+ * The first exception thrown by an task is stored and rethrown by wait(), the remaining tasks are still processed.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include "threadpool.hpp"
+
+ThreadPool::ThreadPool(unsigned int threads)
+{
+	if (threads == 0) threads = defaultThreadCount();
+	for (unsigned int i = 0; i < threads; i++)
+		this->workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->stopping = true;
+	}
+	this->taskAvailable.notify_all();
+	for (std::thread& worker : this->workers)
+		worker.join();
+}
+
+void ThreadPool::workerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->taskAvailable.wait(lock, [this]() { return this->stopping || !this->tasks.empty(); });
+			if (this->tasks.empty()) return;
+			task = std::move(this->tasks.front());
+			this->tasks.pop();
+			this->activeTasks++;
+		}
+
+		try
+		{
+			task();
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			if (!this->failure) this->failure = std::current_exception();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->activeTasks--;
+			if (this->activeTasks == 0 && this->tasks.empty())
+				this->tasksCompleted.notify_all();
+		}
+	}
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->tasks.push(std::move(task));
+	}
+	this->taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	std::unique_lock<std::mutex> lock(this->mutex);
+	this->tasksCompleted.wait(lock, [this]() { return this->activeTasks == 0 && this->tasks.empty(); });
+	if (this->failure)
+	{
+		std::exception_ptr failure = this->failure;
+		this->failure = nullptr;
+		std::rethrow_exception(failure);
+	}
+}
+
+unsigned int ThreadPool::threadCount() const
+{
+	return this->workers.size();
+}
+
+unsigned int ThreadPool::defaultThreadCount()
+{
+	unsigned int threads = std::thread::hardware_concurrency();
+	return threads == 0 ? 1 : threads;
+}
@@ -6,18 +6,96 @@
  * The state of individual inputs can be set and read using the input() function which returns a pointer to the value stored in the table.
  * The state of individual outputs can be set and read using the output() function which returns a pointer to the value stored in the table.
  * The state index of an combination of all inputs can be queried using the find() function.
+ * To make this fast, an index is build once when the table is created, fully defined rows are stored in an
+ * direct addressed array (or hash map for large input counts and sparse tables), rows with DONT_CARE inputs in an cube trie.
+ * The fully defined function of an output can be queried using the outputSets() function.
+ * Outputs with the same (or complementary) cells in all rows have the same (or complementary) function, see outputMatches().
+ * States not defined by any row are DONT_CARE by default, tables read from cube formats (PLA) can set them to FALSE instead.
+ * Output cells of such tables can also be UNDEFINED, in which case only the other outputs are defined by the row.
  *
  *  Created on: 18.09.2025
  *      Author: Marvin K. (M_Marvin)
  */
 
+#include <stack>
 #include "truthtable.hpp"
 
-TruthTable::TruthTable(std::vector<TriStateBool>& tableData, unsigned int inputs, unsigned int outputs)
+TruthTable::TruthTable(std::vector<TriStateBool>& tableData, unsigned int inputs, unsigned int outputs, TriStateBool undefinedValue)
 {
 	this->inputs = inputs;
 	this->outputs = outputs;
 	this->data = std::vector<TriStateBool>(tableData);
+	this->undefinedValue = undefinedValue;
+	buildIndex();
+}
+
+TruthTable::TruthTable(std::vector<TriStateBool>&& tableData, unsigned int inputs, unsigned int outputs, TriStateBool undefinedValue)
+{
+	this->inputs = inputs;
+	this->outputs = outputs;
+	this->data = std::move(tableData);
+	this->undefinedValue = undefinedValue;
+	buildIndex();
+}
+
+void TruthTable::buildIndex()
+{
+	// the index uses the inputs packed into an 64 bit word, larger tables have to use the linear search
+	this->indexed = this->inputs <= 64;
+	if (!this->indexed) return;
+
+	// the array has an entry for every state, so it is only worth it if an good part of them is defined by an row
+	bool direct = this->inputs <= TRUTHTABLE_DIRECT_INDEX_MAX_INPUTS &&
+			(1ULL << this->inputs) <= static_cast<uint64_t>(stateCount()) * TRUTHTABLE_DIRECT_INDEX_MAX_SPARSITY;
+	if (direct)
+		this->stateIndex.assign(1U << this->inputs, stateCount());
+	this->cubeTrie.clear();
+
+	for (unsigned int s = 0; s < stateCount(); s++)
+	{
+		for (unsigned int o = 0; o < this->outputs; o++)
+			if (output(s, o) == TriStateBool::UNDEFINED)
+				this->undefinedOutputs = true;
+
+		uint64_t state = 0;
+		bool hasDontCare = false;
+		for (unsigned int i = 0; i < this->inputs; i++)
+		{
+			TriStateBool in = input(s, i);
+			if (in == TriStateBool::TRUE)
+				state |= 1ULL << i;
+			else if (in == TriStateBool::DONT_CARE)
+				hasDontCare = true;
+		}
+
+		// fully defined rows, only the first row for each state is relevant
+		if (!hasDontCare)
+		{
+			if (direct)
+			{
+				if (this->stateIndex[state] == stateCount())
+					this->stateIndex[state] = s;
+			}
+			else
+				this->stateMap.emplace(state, s);
+			continue;
+		}
+
+		// rows with DONT_CARE inputs, each node stores the lowest row passing through it
+		if (this->cubeTrie.empty())
+			this->cubeTrie.push_back({ {}, s });
+		unsigned int node = 0;
+		for (unsigned int i = 0; i < this->inputs; i++)
+		{
+			unsigned int in = input(s, i);
+			if (this->cubeTrie[node].children[in] == 0)
+			{
+				this->cubeTrie[node].children[in] = this->cubeTrie.size();
+				this->cubeTrie.push_back({ {}, s });
+			}
+			node = this->cubeTrie[node].children[in];
+		}
+	}
 }
 
 TriStateBool TruthTable::input(unsigned int state, unsigned int input) const
@@ -35,6 +113,68 @@ TriStateBool TruthTable::output(unsigned int state, unsigned int output) const
 }
 
 unsigned int TruthTable::find(TriStateBool* inputs) const
+{
+
+	if (!this->indexed) return findLinear(inputs);
+
+	uint64_t state = 0;
+	for (unsigned int i = 0; i < this->inputs; i++)
+	{
+		// DONT_CARE in the query only matches DONT_CARE in the table, the index can not answer that
+		if (inputs[i] == TriStateBool::DONT_CARE) return findLinear(inputs);
+		if (inputs[i] == TriStateBool::TRUE) state |= 1ULL << i;
+	}
+	return find(state);
+
+}
+
+unsigned int TruthTable::find(uint64_t state) const
+{
+
+	if (!this->indexed)
+	{
+		TriStateBool inputs[this->inputs];
+		for (unsigned int i = 0; i < this->inputs; i++)
+			inputs[i] = (state >> i) & 1 ? TriStateBool::TRUE : TriStateBool::FALSE;
+		return findLinear(inputs);
+	}
+
+	// lookup fully defined rows
+	unsigned int row = stateCount();
+	if (!this->stateIndex.empty())
+	{
+		row = this->stateIndex[state];
+	}
+	else
+	{
+		auto entry = this->stateMap.find(state);
+		if (entry != this->stateMap.end()) row = entry->second;
+	}
+
+	// search the cube trie for an earlier row, following both the matching and the DONT_CARE branches
+	if (this->cubeTrie.empty()) return row;
+	std::stack<std::pair<unsigned int, unsigned int>> pending;
+	pending.push({ 0, 0 });
+	while (!pending.empty())
+	{
+		auto [node, depth] = pending.top();
+		pending.pop();
+		if (this->cubeTrie[node].row >= row) continue;
+		if (depth == this->inputs)
+		{
+			row = this->cubeTrie[node].row;
+			continue;
+		}
+		unsigned int exact = this->cubeTrie[node].children[(state >> depth) & 1];
+		unsigned int dontCare = this->cubeTrie[node].children[TriStateBool::DONT_CARE];
+		if (exact != 0) pending.push({ exact, depth + 1 });
+		if (dontCare != 0) pending.push({ dontCare, depth + 1 });
+	}
+	return row;
+
+}
+
+unsigned int TruthTable::findLinear(TriStateBool* inputs) const
 {
 
 	for (unsigned int s = 0; s < stateCount(); s++)
@@ -51,6 +191,96 @@ unsigned int TruthTable::find(TriStateBool* inputs) const
 	return stateCount(); // this means it is not defined, aka dont't care
 }
 
+void TruthTable::outputSets(unsigned int output, BitSet& onSet, BitSet& dcSet) const
+{
+	// the sets are indexed by the state of all inputs, with the first input as the most significant bit
+	// check_table() ensures that this is only used for at most TRUTHTABLE_MAX_ENUMERATED_INPUTS inputs
+	unsigned int states = 1U << this->inputs;
+	BitSet defined(states);
+	onSet = BitSet(states);
+	dcSet = BitSet(states);
+
+	for (unsigned int s = 0; s < stateCount(); s++)
+	{
+		// the inputs of a row describe a cube, DONT_CARE inputs are expanded to all states they cover
+		unsigned int fixed = 0;
+		unsigned int free = 0;
+		for (unsigned int i = 0; i < this->inputs; i++)
+		{
+			unsigned int bit = 1U << (this->inputs - 1 - i);
+			TriStateBool in = input(s, i);
+			if (in == TriStateBool::DONT_CARE)
+				free |= bit;
+			else if (in == TriStateBool::TRUE)
+				fixed |= bit;
+		}
+
+		// like find(), the first row matching an state defines its value, unless the row does not define this output
+		TriStateBool value = this->output(s, output);
+		if (value == TriStateBool::UNDEFINED) continue;
+		unsigned int sub = 0;
+		do
+		{
+			unsigned int state = fixed | sub;
+			if (!defined.test(state))
+			{
+				defined.set(state);
+				if (value == TriStateBool::TRUE)
+					onSet.set(state);
+				else if (value == TriStateBool::DONT_CARE)
+					dcSet.set(state);
+			}
+			sub = (sub - free) & free;
+		}
+		while (sub != 0);
+	}
+
+	// states not defined in the table are DONT_CARE, or FALSE for tables read from cube formats
+	if (this->undefinedValue == TriStateBool::FALSE) return;
+	for (unsigned int state = 0; state < states; state++)
+		if (!defined.test(state))
+			(this->undefinedValue == TriStateBool::TRUE ? onSet : dcSet).set(state);
+}
+
+TriStateBool TruthTable::undefinedStateValue() const
+{
+	return this->undefinedValue;
+}
+
+bool TruthTable::hasUndefinedOutputs() const
+{
+	return this->undefinedOutputs;
+}
+
+uint64_t TruthTable::outputFingerprint(unsigned int output, bool complement) const
+{
+	// FNV-1a hash of the output cells of all rows, the complement swaps TRUE and FALSE
+	uint64_t hash = 14695981039346656037ULL;
+	for (unsigned int s = 0; s < stateCount(); s++)
+	{
+		TriStateBool value = this->output(s, output);
+		if (complement && (value == TriStateBool::TRUE || value == TriStateBool::FALSE))
+			value = value == TriStateBool::TRUE ? TriStateBool::FALSE : TriStateBool::TRUE;
+		hash = (hash ^ value) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+bool TruthTable::outputMatches(unsigned int output, unsigned int other, bool complement) const
+{
+	// states not defined by any row have the same value for all outputs, so they are only complementary if they are DONT_CARE
+	if (complement && this->undefinedValue != TriStateBool::DONT_CARE) return false;
+	for (unsigned int s = 0; s < stateCount(); s++)
+	{
+		TriStateBool a = this->output(s, output);
+		TriStateBool b = this->output(s, other);
+		if (complement && (b == TriStateBool::TRUE || b == TriStateBool::FALSE))
+			b = b == TriStateBool::TRUE ? TriStateBool::FALSE : TriStateBool::TRUE;
+		if (a != b) return false;
+	}
+	return true;
+}
+
 unsigned int TruthTable::inputCount() const
 {
 	return this->inputs;
@@ -0,0 +1,425 @@
+/*
+ * zdd.cpp
+ *
+ * Implicit prime chart based on zero-suppressed decision diagrams (ZDDs), for functions with too many primes to enumerate them.
+ * The set of primes is an ZDD of cubes, the minterms still to be covered are an BDD, the same recursion as for the explicit
+ * primes of the BDD engine builds the ZDD, with the set difference and union done on the diagrams:
+ *   primes(f) = primes(f0 * f1) + x' * (primes(f0) - primes(f0 * f1)) + x * (primes(f1) - primes(f0 * f1))
+ *
+ * The chart is reduced without enumerating the primes or the minterms:
+ * - the minterms covered by exactly one prime are the minterms covered at least once, minus the ones covered at least twice,
+ *   the prime containing one of these minterms is essential.
+ * - primes which do not contain any minterm which is still to be covered are removed.
+ * - an minterm m1 is removed if its neighbour m2 (differing in input i) is covered only by primes not depending on input i,
+ *   since then all primes covering m2 also cover m1.
+ * Only the essential primes and the primes of the remaining cyclic core are converted to cubes.
+ *
+ *  Created on: 16.10.2026
+ *      Author: Marvin K. (M_Marvin)
+ */
+
+#include "zdd.hpp"
+
+size_t ZDDOperationKeyHash::operator()(const ZDDOperationKey& key) const
+{
+	uint64_t value = (static_cast<uint64_t>(key.a) << 32 | key.b) * 0x9E3779B97F4A7C15ULL;
+	return std::hash<uint64_t>()(value ^ key.operation);
+}
+
+ZDDManager::ZDDManager(unsigned int inputs)
+{
+	// the terminals are below the last variable
+	this->inputs = inputs;
+	this->nodes.push_back({ inputs * 2, ZDD_EMPTY, ZDD_EMPTY });
+	this->nodes.push_back({ inputs * 2, ZDD_BASE, ZDD_BASE });
+}
+
+zdd_node_t ZDDManager::makeNode(unsigned int variable, zdd_node_t low, zdd_node_t high)
+{
+	// an node without cubes containing its variable is not stored
+	if (high == ZDD_EMPTY) return low;
+	BDDNode node = { variable, low, high };
+	auto entry = this->uniqueTable.try_emplace(node, this->nodes.size());
+	if (entry.second)
+		this->nodes.push_back(node);
+	return entry.first->second;
+}
+
+zdd_node_t ZDDManager::apply(ZDDOperation operation, zdd_node_t a, zdd_node_t b)
+{
+
+	switch (operation)
+	{
+	case ZDD_UNION:
+		if (a == ZDD_EMPTY || a == b) return b;
+		if (b == ZDD_EMPTY) return a;
+		if (a > b) std::swap(a, b);
+		break;
+	case ZDD_INTERSECTION:
+		if (a == ZDD_EMPTY || b == ZDD_EMPTY) return ZDD_EMPTY;
+		if (a == b) return a;
+		if (a > b) std::swap(a, b);
+		break;
+	case ZDD_DIFFERENCE:
+		if (a == ZDD_EMPTY || a == b) return ZDD_EMPTY;
+		if (b == ZDD_EMPTY) return a;
+		break;
+	case ZDD_SUBSET:
+		return subset(a, b);
+	}
+
+	ZDDOperationKey key = { operation, a, b };
+	auto cached = this->computedTable.find(key);
+	if (cached != this->computedTable.end()) return cached->second;
+
+	/**
+	 * unlike for BDDs, an set not having the top variable only continues in the low branch,
+	 * since none of its cubes contains the variable.
+	 */
+	BDDNode nodeA = this->nodes[a];
+	BDDNode nodeB = this->nodes[b];
+	zdd_node_t result;
+	if (nodeA.variable < nodeB.variable)
+	{
+		zdd_node_t low = apply(operation, nodeA.low, b);
+		result = operation == ZDD_INTERSECTION ? low : makeNode(nodeA.variable, low, nodeA.high);
+	}
+	else if (nodeB.variable < nodeA.variable)
+	{
+		zdd_node_t low = apply(operation, a, nodeB.low);
+		result = operation == ZDD_UNION ? makeNode(nodeB.variable, low, nodeB.high) : low;
+	}
+	else
+	{
+		zdd_node_t low = apply(operation, nodeA.low, nodeB.low);
+		zdd_node_t high = apply(operation, nodeA.high, nodeB.high);
+		result = makeNode(nodeA.variable, low, high);
+	}
+
+	this->computedTable.emplace(key, result);
+	return result;
+
+}
+
+zdd_node_t ZDDManager::subset(zdd_node_t set, unsigned int variable)
+{
+
+	BDDNode node = this->nodes[set];
+	if (node.variable > variable) return ZDD_EMPTY;
+	if (node.variable == variable) return makeNode(variable, ZDD_EMPTY, node.high);
+
+	ZDDOperationKey key = { ZDDOperation::ZDD_SUBSET, set, variable };
+	auto cached = this->computedTable.find(key);
+	if (cached != this->computedTable.end()) return cached->second;
+
+	zdd_node_t low = subset(node.low, variable);
+	zdd_node_t high = subset(node.high, variable);
+	zdd_node_t result = makeNode(node.variable, low, high);
+	this->computedTable.emplace(key, result);
+	return result;
+
+}
+
+zdd_node_t ZDDManager::cube(const QMCCube& cube)
+{
+	// built from the bottom up, so that each node only has to be created once
+	zdd_node_t node = ZDD_BASE;
+	for (unsigned int i = this->inputs; i-- > 0; )
+	{
+		if (!(cube.mask & (1ULL << i))) continue;
+		node = makeNode(i * 2 + ((cube.value & (1ULL << i)) ? 0 : 1), ZDD_EMPTY, node);
+	}
+	return node;
+}
+
+bool ZDDManager::findCube(zdd_node_t set, uint64_t state, QMCCube& cube, std::unordered_set<zdd_node_t>& dead) const
+{
+	if (set == ZDD_BASE) return true;
+	if (set == ZDD_EMPTY || dead.count(set)) return false;
+	const BDDNode& node = this->nodes[set];
+	if (findCube(node.low, state, cube, dead)) return true;
+	// the literal of the node has to match the state
+	uint64_t bit = 1ULL << (node.variable / 2);
+	if (((state & bit) != 0) == (node.variable % 2 == 0) && findCube(node.high, state, cube, dead))
+	{
+		cube.mask |= bit;
+		cube.value |= state & bit;
+		return true;
+	}
+	dead.insert(set);
+	return false;
+}
+
+bool ZDDManager::containingCube(zdd_node_t set, uint64_t state, QMCCube& cube) const
+{
+	// nodes without an cube containing the state are remembered, so that each node is visited only once
+	std::unordered_set<zdd_node_t> dead;
+	cube = {};
+	return findCube(set, state, cube, dead);
+}
+
+const BDDNode& ZDDManager::node(zdd_node_t set) const
+{
+	return this->nodes[set];
+}
+
+double ZDDManager::count(zdd_node_t set)
+{
+	// an double, since the number of cubes can exceed any integer type
+	if (set == ZDD_EMPTY) return 0;
+	if (set == ZDD_BASE) return 1;
+	auto cached = this->countTable.find(set);
+	if (cached != this->countTable.end()) return cached->second;
+	BDDNode node = this->nodes[set];
+	double result = count(node.low) + count(node.high);
+	this->countTable.emplace(set, result);
+	return result;
+}
+
+void ZDDManager::cubes(zdd_node_t set, QMCCube cube, std::vector<QMCCube>& cubes) const
+{
+	if (set == ZDD_EMPTY) return;
+	if (set == ZDD_BASE)
+	{
+		cubes.push_back(cube);
+		return;
+	}
+	const BDDNode& node = this->nodes[set];
+	this->cubes(node.low, cube, cubes);
+	uint64_t bit = 1ULL << (node.variable / 2);
+	cube.mask |= bit;
+	if (node.variable % 2 == 0) cube.value |= bit;
+	this->cubes(node.high, cube, cubes);
+}
+
+void ZDDManager::cubes(zdd_node_t set, std::vector<QMCCube>& cubes) const
+{
+	this->cubes(set, {}, cubes);
+}
+
+unsigned int ZDDManager::nodeCount() const
+{
+	return this->nodes.size();
+}
+
+ImplicitPrimeChart::ImplicitPrimeChart(BDDManager& bdd) : bdd(bdd), zdd(bdd.variableCount()) {}
+
+zdd_node_t ImplicitPrimeChart::primeSet(bdd_node_t function)
+{
+
+	if (function == BDD_FALSE) return ZDD_EMPTY;
+	if (function == BDD_TRUE) return ZDD_BASE;
+	auto cached = this->primeTable.find(function);
+	if (cached != this->primeTable.end()) return cached->second;
+
+	BDDNode node = this->bdd.node(function);
+	zdd_node_t both = primeSet(this->bdd.apply(BDDOperation::BDD_AND, node.low, node.high));
+
+	// the primes of the cofactors which are not primes of both need the literal of the variable
+	zdd_node_t low = this->zdd.apply(ZDDOperation::ZDD_DIFFERENCE, primeSet(node.low), both);
+	zdd_node_t high = this->zdd.apply(ZDDOperation::ZDD_DIFFERENCE, primeSet(node.high), both);
+	zdd_node_t result = this->zdd.makeNode(node.variable * 2, this->zdd.makeNode(node.variable * 2 + 1, both, low), high);
+
+	this->primeTable.emplace(function, result);
+	return result;
+
+}
+
+void ImplicitPrimeChart::split(zdd_node_t cubes, unsigned int input, zdd_node_t& none, zdd_node_t& positive, zdd_node_t& negative) const
+{
+	// the cubes without an literal of the input, and the cubes with the positive and negative literal without it
+	none = cubes;
+	positive = ZDD_EMPTY;
+	negative = ZDD_EMPTY;
+	if (this->zdd.node(none).variable == input * 2)
+	{
+		positive = this->zdd.node(none).high;
+		none = this->zdd.node(none).low;
+	}
+	if (this->zdd.node(none).variable == input * 2 + 1)
+	{
+		negative = this->zdd.node(none).high;
+		none = this->zdd.node(none).low;
+	}
+}
+
+zdd_node_t ImplicitPrimeChart::intersecting(zdd_node_t cubes, bdd_node_t function)
+{
+
+	// the cube without any literal covers all states, so it intersects every function except FALSE
+	if (cubes == ZDD_EMPTY || function == BDD_FALSE) return ZDD_EMPTY;
+	if (function == BDD_TRUE || cubes == ZDD_BASE) return cubes;
+
+	uint64_t key = static_cast<uint64_t>(cubes) << 32 | function;
+	auto cached = this->intersectTable.find(key);
+	if (cached != this->intersectTable.end()) return cached->second;
+
+	// split the cubes by their literal of the topmost input, and the function by its value
+	unsigned int input = std::min(this->zdd.node(cubes).variable / 2, this->bdd.node(function).variable);
+	zdd_node_t none, positive, negative;
+	split(cubes, input, none, positive, negative);
+	bdd_node_t function0 = this->bdd.cofactor(function, input, false);
+	bdd_node_t function1 = this->bdd.cofactor(function, input, true);
+
+	/**
+	 * an cube without an literal of the input intersects the function if it intersects any of the two cofactors.
+	 * the union of both sets of cubes is much smaller than the BDD of the union of both cofactors would be.
+	 */
+	zdd_node_t low = this->zdd.apply(ZDDOperation::ZDD_UNION, intersecting(none, function0), intersecting(none, function1));
+	zdd_node_t lowNegative = intersecting(negative, function0);
+	zdd_node_t high = intersecting(positive, function1);
+	zdd_node_t result = this->zdd.makeNode(input * 2, this->zdd.makeNode(input * 2 + 1, low, lowNegative), high);
+
+	this->intersectTable.emplace(key, result);
+	return result;
+
+}
+
+std::pair<bdd_node_t, bdd_node_t> ImplicitPrimeChart::coverage(zdd_node_t cubes, bdd_node_t states)
+{
+
+	// returns the states covered by at least one of the cubes, and the states covered by at least two of them
+	if (cubes == ZDD_EMPTY || states == BDD_FALSE) return { BDD_FALSE, BDD_FALSE };
+	if (cubes == ZDD_BASE) return { states, BDD_FALSE };
+
+	uint64_t key = static_cast<uint64_t>(cubes) << 32 | states;
+	auto cached = this->coverageTable.find(key);
+	if (cached != this->coverageTable.end()) return cached->second;
+
+	/**
+	 * only the given states are considered, the union of all cubes is usually much larger than the minterms still to be covered.
+	 * for each value of the input, the cubes without literal and the cubes with the literal of this value cover the states.
+	 * an state is covered twice if it is covered twice by one part, or once by both.
+	 */
+	unsigned int input = std::min(this->zdd.node(cubes).variable / 2, this->bdd.node(states).variable);
+	zdd_node_t none, positive, negative;
+	split(cubes, input, none, positive, negative);
+	bdd_node_t once[2];
+	bdd_node_t twice[2];
+	for (bool value : { false, true })
+	{
+		bdd_node_t cofactor = this->bdd.cofactor(states, input, value);
+		auto [noneOnce, noneTwice] = coverage(none, cofactor);
+		auto [literalOnce, literalTwice] = coverage(value ? positive : negative, cofactor);
+		once[value] = this->bdd.apply(BDDOperation::BDD_OR, noneOnce, literalOnce);
+		twice[value] = this->bdd.apply(BDDOperation::BDD_OR, noneTwice, literalTwice);
+		twice[value] = this->bdd.apply(BDDOperation::BDD_OR, twice[value], this->bdd.apply(BDDOperation::BDD_AND, noneOnce, literalOnce));
+	}
+
+	std::pair<bdd_node_t, bdd_node_t> result(this->bdd.makeNode(input, once[0], once[1]), this->bdd.makeNode(input, twice[0], twice[1]));
+	this->coverageTable.emplace(key, result);
+	return result;
+
+}
+
+void ImplicitPrimeChart::initialize(bdd_node_t onSet, bdd_node_t dcSet)
+{
+	// the primes of ON + DONT_CARE, only the ones covering at least one TRUE state are needed
+	this->minterms = onSet;
+	this->primes = intersecting(primeSet(this->bdd.apply(BDDOperation::BDD_OR, onSet, dcSet)), onSet);
+}
+
+unsigned int ImplicitPrimeChart::extractEPIs(std::vector<QMCImplicant>& essentialPrimes)
+{
+
+	// the minterms covered by exactly one prime
+	auto [once, twice] = coverage(this->primes, this->minterms);
+	bdd_node_t unique = this->bdd.apply(BDDOperation::BDD_AND_NOT, once, twice);
+
+	/**
+	 * the essential primes are converted to cubes anyway, so they are looked up one by one.
+	 * the prime containing an minterm covered only once is essential, the other minterms covered only by it are removed with it.
+	 */
+	unsigned int extracted = 0;
+	zdd_node_t essential = ZDD_EMPTY;
+	uint64_t state;
+	while (this->bdd.pickState(unique, {}, state))
+	{
+		QMCCube prime;
+		this->zdd.containingCube(this->primes, state, prime);
+		essentialPrimes.emplace_back().initialize(prime, this->bdd.variableCount());
+		essential = this->zdd.apply(ZDDOperation::ZDD_UNION, essential, this->zdd.cube(prime));
+		bdd_node_t covered = this->bdd.cube(prime);
+		unique = this->bdd.apply(BDDOperation::BDD_AND_NOT, unique, covered);
+		this->minterms = this->bdd.apply(BDDOperation::BDD_AND_NOT, this->minterms, covered);
+		extracted++;
+	}
+
+	this->primes = this->zdd.apply(ZDDOperation::ZDD_DIFFERENCE, this->primes, essential);
+	return extracted;
+
+}
+
+bool ImplicitPrimeChart::removeDominatedPrimes()
+{
+	// primes which do not cover any minterm anymore are dominated by every other prime
+	zdd_node_t remaining = intersecting(this->primes, this->minterms);
+	bool removed = remaining != this->primes;
+	this->primes = remaining;
+	return removed;
+}
+
+bool ImplicitPrimeChart::removeDominatingMinterms()
+{
+
+	bool removed = false;
+	for (unsigned int i = 0; i < this->bdd.variableCount(); i++)
+	{
+		uint64_t bit = 1ULL << i;
+		for (bool value : { true, false })
+		{
+			/**
+			 * the minterms with the input at this value which are not covered by any prime with an literal for it.
+			 * all primes covering such an minterm also cover its neighbour with the input at the other value,
+			 * so the neighbour is fulfilled automatically and can be removed, the minterm itself is kept.
+			 */
+			zdd_node_t dependent = this->zdd.subset(this->primes, i * 2 + (value ? 0 : 1));
+			bdd_node_t independent = this->bdd.apply(BDDOperation::BDD_AND_NOT, this->minterms, coverage(dependent, this->minterms).first);
+			independent = this->bdd.apply(BDDOperation::BDD_AND, independent, this->bdd.cube({ value ? bit : 0, bit }));
+			bdd_node_t neighbours = this->bdd.apply(BDDOperation::BDD_AND, this->bdd.cube({ value ? 0 : bit, bit }), this->bdd.cofactor(independent, i, value));
+			bdd_node_t dominating = this->bdd.apply(BDDOperation::BDD_AND, this->minterms, neighbours);
+			if (dominating == BDD_FALSE) continue;
+			this->minterms = this->bdd.apply(BDDOperation::BDD_AND_NOT, this->minterms, dominating);
+			removed = true;
+		}
+	}
+	return removed;
+
+}
+
+unsigned int ImplicitPrimeChart::reduce(std::vector<QMCImplicant>& essentialPrimes)
+{
+	// like for the explicit chart, repeat until the chart can not be reduced any further
+	unsigned int extracted = 0;
+	while (this->minterms != BDD_FALSE)
+	{
+		unsigned int epis = extractEPIs(essentialPrimes);
+		extracted += epis;
+		bool changes = epis > 0;
+		changes |= removeDominatedPrimes();
+		changes |= removeDominatingMinterms();
+		if (!changes) break;
+	}
+	return extracted;
+}
+
+void ImplicitPrimeChart::primeImplicants(std::vector<QMCCube>& primes) const
+{
+	primes.clear();
+	this->zdd.cubes(this->primes, primes);
+}
+
+double ImplicitPrimeChart::primeCount()
+{
+	return this->zdd.count(this->primes);
+}
+
+bdd_node_t ImplicitPrimeChart::mintermSet() const
+{
+	return this->minterms;
+}
+
+unsigned int ImplicitPrimeChart::nodeCount() const
+{
+	return this->zdd.nodeCount();
+}